@@ -0,0 +1,59 @@
+#include "config_reloader.h"
+
+#include <boost/asio/post.hpp>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+
+#include "json_loader.h"
+#include "map_binary.h"
+
+namespace config_reloader {
+
+using namespace std::literals;
+namespace sys = boost::system;
+
+model::Game LoadGameFile(const std::filesystem::path& path, unsigned load_threads) {
+    return path.extension() == ".bin"sv ? map_binary::LoadGame(path) : json_loader::LoadGame(path, load_threads);
+}
+
+ConfigReloader::ConfigReloader(net::io_context& ioc, std::filesystem::path path, unsigned load_threads,
+                               http_handler::RequestHandler& handler)
+    : signals_{ioc, SIGHUP}
+    , path_{std::move(path)}
+    , load_threads_{load_threads}
+    , handler_{handler} {
+    WaitSignal();
+}
+
+ConfigReloader::~ConfigReloader() {
+    signals_.cancel();
+    // Деструктор thread_pool отбрасывает ещё не начатые задачи, а join их выполняет
+    loader_.join();
+}
+
+void ConfigReloader::WaitSignal() {
+    signals_.async_wait([this](const sys::error_code& ec, [[maybe_unused]] int signal_number) {
+        if (!ec) {
+            net::post(loader_, [this] {
+                Reload();
+            });
+            WaitSignal();
+        }
+    });
+}
+
+void ConfigReloader::Reload() {
+    try {
+        auto game = std::make_shared<const model::Game>(LoadGameFile(path_, load_threads_));
+        if (game->GetMaps().empty()) {
+            throw std::runtime_error("Game config has no maps");
+        }
+        handler_.SetGame(std::move(game));
+        std::cout << "Game config has been reloaded"sv << std::endl;
+    } catch (const std::exception& ex) {
+        std::cerr << "Failed to reload game config: "sv << ex.what() << std::endl;
+    }
+}
+
+}  // namespace config_reloader
@@ -0,0 +1,56 @@
+#pragma once
+#include "sdk.h"
+//
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/signal_set.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include <filesystem>
+
+#include "model.h"
+#include "request_handler.h"
+
+namespace config_reloader {
+
+namespace net = boost::asio;
+
+/*
+ * Загружает игру из двоичного файла карт, собранного map_compiler, или из JSON.
+ * Двоичный файл отображается в память без разбора. JSON разбирается потоково,
+ * а при load_threads > 1 - целиком в памяти с построением карт на load_threads потоках
+ */
+model::Game LoadGameFile(const std::filesystem::path& path, unsigned load_threads);
+
+/*
+ * По сигналу SIGHUP перечитывает файл карт в отдельном потоке и подменяет модель игры
+ * в обработчике запросов. Если файл не загрузился или в нём нет карт, сервер продолжает
+ * работать со старой моделью. Повторные сигналы во время загрузки ставят её в очередь.
+ *
+ * Модель из двоичного файла ссылается на отображённый в память файл до тех пор, пока
+ * её используют запросы. Поэтому новый файл карт должен заменять старый переименованием
+ * (так его записывает map_compiler), а не перезаписью на месте: усечение файла,
+ * отображённого в память, аварийно завершает сервер
+ */
+class ConfigReloader {
+public:
+    ConfigReloader(net::io_context& ioc, std::filesystem::path path, unsigned load_threads,
+                   http_handler::RequestHandler& handler);
+
+    ConfigReloader(const ConfigReloader&) = delete;
+    ConfigReloader& operator=(const ConfigReloader&) = delete;
+
+    // Дожидается загрузок, поставленных в очередь до разрушения
+    ~ConfigReloader();
+
+private:
+    void WaitSignal();
+
+    void Reload();
+
+    net::signal_set signals_;
+    std::filesystem::path path_;
+    unsigned load_threads_;
+    http_handler::RequestHandler& handler_;
+    net::thread_pool loader_{1};
+};
+
+}  // namespace config_reloader
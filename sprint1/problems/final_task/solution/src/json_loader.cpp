@@ -2,9 +2,23 @@
 
 #include "json_loader.h"
 
-#include <iostream>
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include <boost/json/basic_parser_impl.hpp>
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdint>
+#include <exception>
 #include <fstream>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace json_loader {
 
@@ -62,49 +76,665 @@ namespace json_loader {
 
 
 
-model::Game LoadGame(const std::filesystem::path& json_path) {
-    // Загрузить содержимое файла json_path, например, в виде строки
-    // Распарсить строку как JSON, используя boost::json::parse
-    // Загрузить модель игры из файла
-    model::Game game;
-    std::ifstream file(json_path.string());
-    std::string jsonString;
-    if (!file)
-    {
-        std::cout << "Can't open JSON file "sv << json_path << std::endl;
+namespace {
+
+namespace net = boost::asio;
+
+/*
+ * Обработчик событий потокового разбора конфигурации (boost::json::basic_parser).
+ * Дороги, здания и офисы создаются прямо по ходу разбора, дерево JSON не строится.
+ * Если id и name карты встретились раньше её объектов, объекты сразу добавляются в карту,
+ * иначе накапливаются до конца описания карты.
+ * Разобранные карты дописываются в maps. Неизвестные ключи пропускаются.
+ */
+class ConfigHandler {
+public:
+    static constexpr std::size_t max_object_size = std::size_t(-1);
+    static constexpr std::size_t max_array_size = std::size_t(-1);
+    static constexpr std::size_t max_key_size = std::size_t(-1);
+    static constexpr std::size_t max_string_size = std::size_t(-1);
+
+    // Корень документа: вся конфигурация, конфигурация без разбора описаний карт
+    // (карты проверяются отдельно) или описание одной карты
+    enum class Root { CONFIG, CONFIG_WITHOUT_MAPS, MAP };
+
+    ConfigHandler(Root root, std::vector<model::Map>& maps)
+        : root_{root}
+        , maps_{maps} {
+    }
+
+    const std::string& GetError() const noexcept {
+        return error_;
+    }
+
+    bool on_document_begin(json::error_code&) {
+        return true;
+    }
+
+    bool on_document_end(json::error_code&) {
+        return true;
     }
-    else {
-        while (file)
-        {
-            std::string strInput;
-            std::getline(file, strInput);
-            jsonString.append(strInput);
+
+    bool on_object_begin(json::error_code& ec) {
+        if (stack_.empty()) {
+            if (root_ == Root::MAP) {
+                BeginMap();
+            }
+            stack_.push_back(root_ == Root::MAP ? Context::MAP : Context::ROOT);
+            return true;
+        }
+        switch (stack_.back()) {
+            case Context::MAPS:
+                if (root_ == Root::CONFIG_WITHOUT_MAPS) {
+                    stack_.push_back(Context::SKIP);
+                    return true;
+                }
+                BeginMap();
+                stack_.push_back(Context::MAP);
+                return true;
+            case Context::ROADS:
+                fields_ = {};
+                stack_.push_back(Context::ROAD);
+                return true;
+            case Context::BUILDINGS:
+                fields_ = {};
+                stack_.push_back(Context::BUILDING);
+                return true;
+            case Context::OFFICES:
+                fields_ = {};
+                stack_.push_back(Context::OFFICE);
+                return true;
+            default:
+                return BeginSkipped(ec);
         }
     }
-    auto jsonValue = json::parse(jsonString);
-    for (const auto& map_ : jsonValue.at("maps"s).as_array())
-    {
-        std::string ID = map_.as_object().at("id"s).as_string().data();
-        std::string mapName = map_.as_object().at("name"s).as_string().data();
-        model::Map::Id map_Id{ ID };
-        model::Map map(map_Id, mapName);        
-        
-        for (const auto& road_ : map_.at("roads"s).as_array())
-        {
-            map.AddRoad(GetRoad(road_.as_object()));          
+
+    bool on_object_end(std::size_t, json::error_code& ec) {
+        const Context context = stack_.back();
+        stack_.pop_back();
+        switch (context) {
+            case Context::MAP:
+                return EndMap(ec);
+            case Context::ROAD:
+                return EndRoad(ec);
+            case Context::BUILDING:
+                return EndBuilding(ec);
+            case Context::OFFICE:
+                return EndOffice(ec);
+            default:
+                return true;
+        }
+    }
+
+    bool on_array_begin(json::error_code& ec) {
+        if (stack_.empty()) {
+            return Fail(ec, "Config must be an object"s);
+        }
+        const Context context = stack_.back();
+        if (context == Context::ROOT && key_ == "maps"sv) {
+            stack_.push_back(Context::MAPS);
+        } else if (context == Context::MAP && key_ == "roads"sv) {
+            stack_.push_back(Context::ROADS);
+        } else if (context == Context::MAP && key_ == "buildings"sv) {
+            stack_.push_back(Context::BUILDINGS);
+        } else if (context == Context::MAP && key_ == "offices"sv) {
+            stack_.push_back(Context::OFFICES);
+        } else {
+            return BeginSkipped(ec);
+        }
+        return true;
+    }
+
+    bool on_array_end(std::size_t, json::error_code&) {
+        stack_.pop_back();
+        return true;
+    }
+
+    bool on_key_part(json::string_view s, std::size_t, json::error_code&) {
+        AppendPart(key_, key_complete_, s);
+        return true;
+    }
+
+    bool on_key(json::string_view s, std::size_t, json::error_code&) {
+        AppendPart(key_, key_complete_, s);
+        key_complete_ = true;
+        return true;
+    }
+
+    bool on_string_part(json::string_view s, std::size_t, json::error_code&) {
+        AppendPart(string_, string_complete_, s);
+        return true;
+    }
+
+    bool on_string(json::string_view s, std::size_t, json::error_code& ec) {
+        AppendPart(string_, string_complete_, s);
+        string_complete_ = true;
+        if (auto field = FindStringField()) {
+            *field = string_;
+            TryCreateMap();
+            return true;
+        }
+        return CheckNotField(ec);
+    }
+
+    bool on_number_part(json::string_view, json::error_code&) {
+        return true;
+    }
+
+    bool on_int64(std::int64_t i, json::string_view, json::error_code& ec) {
+        return OnInteger(i, ec);
+    }
+
+    bool on_uint64(std::uint64_t u, json::string_view, json::error_code& ec) {
+        if (u > static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max())) {
+            return FindIntegerField() ? Fail(ec, "Value of "s + key_ + " is too large"s) : true;
+        }
+        return OnInteger(static_cast<std::int64_t>(u), ec);
+    }
+
+    bool on_double(double, json::string_view, json::error_code& ec) {
+        return CheckNotField(ec);
+    }
+
+    bool on_bool(bool, json::error_code& ec) {
+        return CheckNotField(ec);
+    }
+
+    bool on_null(json::error_code& ec) {
+        return CheckNotField(ec);
+    }
+
+    bool on_comment_part(json::string_view, json::error_code&) {
+        return true;
+    }
+
+    bool on_comment(json::string_view, json::error_code&) {
+        return true;
+    }
+
+private:
+    // Что разбирается сейчас. SKIP - содержимое неизвестного ключа
+    enum class Context { ROOT, MAPS, MAP, ROADS, ROAD, BUILDINGS, BUILDING, OFFICES, OFFICE, SKIP };
+
+    // Поля разбираемой дороги, здания или офиса
+    struct Fields {
+        std::optional<std::int64_t> x0, y0, x1, y1;
+        std::optional<std::int64_t> x, y, w, h;
+        std::optional<std::int64_t> offset_x, offset_y;
+        std::optional<std::string> id;
+    };
+
+    static void AppendPart(std::string& str, bool& complete, json::string_view part) {
+        if (complete) {
+            str.clear();
+            complete = false;
+        }
+        str.append(part.data(), part.size());
+    }
+
+    bool Fail(json::error_code& ec, std::string message) {
+        error_ = std::move(message);
+        ec = boost::system::errc::make_error_code(boost::system::errc::invalid_argument);
+        return false;
+    }
+
+    bool BeginSkipped(json::error_code& ec) {
+        if (!CheckNotField(ec)) {
+            return false;
+        }
+        stack_.push_back(Context::SKIP);
+        return true;
+    }
+
+    // Значение неподходящего типа у известного поля
+    bool CheckNotField(json::error_code& ec) {
+        if (stack_.empty()) {
+            return Fail(ec, "Config must be an object"s);
+        }
+        switch (stack_.back()) {
+            case Context::MAPS:
+                return Fail(ec, "Map description must be an object"s);
+            case Context::ROADS:
+                return Fail(ec, "Road description must be an object"s);
+            case Context::BUILDINGS:
+                return Fail(ec, "Building description must be an object"s);
+            case Context::OFFICES:
+                return Fail(ec, "Office description must be an object"s);
+            case Context::ROOT:
+                if (key_ == "maps"sv) {
+                    return Fail(ec, "Value of maps must be an array"s);
+                }
+                break;
+            case Context::MAP:
+                if (key_ == "roads"sv || key_ == "buildings"sv || key_ == "offices"sv) {
+                    return Fail(ec, "Value of "s + key_ + " must be an array"s);
+                }
+                break;
+            default:
+                break;
+        }
+        if (FindIntegerField()) {
+            return Fail(ec, "Value of "s + key_ + " must be an integer"s);
+        }
+        if (FindStringField()) {
+            return Fail(ec, "Value of "s + key_ + " must be a string"s);
+        }
+        return true;
+    }
+
+    bool OnInteger(std::int64_t value, json::error_code& ec) {
+        if (auto field = FindIntegerField()) {
+            *field = value;
+            return true;
+        }
+        return CheckNotField(ec);
+    }
+
+    std::optional<std::int64_t>* FindIntegerField() {
+        if (stack_.empty()) {
+            return nullptr;
+        }
+        switch (stack_.back()) {
+            case Context::ROAD:
+                return key_ == "x0"sv   ? &fields_.x0
+                     : key_ == "y0"sv ? &fields_.y0
+                     : key_ == "x1"sv ? &fields_.x1
+                     : key_ == "y1"sv ? &fields_.y1
+                                      : nullptr;
+            case Context::BUILDING:
+                return key_ == "x"sv   ? &fields_.x
+                     : key_ == "y"sv ? &fields_.y
+                     : key_ == "w"sv ? &fields_.w
+                     : key_ == "h"sv ? &fields_.h
+                                     : nullptr;
+            case Context::OFFICE:
+                return key_ == "x"sv         ? &fields_.x
+                     : key_ == "y"sv       ? &fields_.y
+                     : key_ == "offsetX"sv ? &fields_.offset_x
+                     : key_ == "offsetY"sv ? &fields_.offset_y
+                                           : nullptr;
+            default:
+                return nullptr;
+        }
+    }
+
+    std::optional<std::string>* FindStringField() {
+        if (stack_.empty()) {
+            return nullptr;
         }
+        switch (stack_.back()) {
+            case Context::MAP:
+                return key_ == "id"sv ? &map_id_ : key_ == "name"sv ? &map_name_ : nullptr;
+            case Context::OFFICE:
+                return key_ == "id"sv ? &fields_.id : nullptr;
+            default:
+                return nullptr;
+        }
+    }
+
+    void BeginMap() {
+        map_.reset();
+        map_id_.reset();
+        map_name_.reset();
+        roads_.clear();
+        buildings_.clear();
+        offices_.clear();
+    }
+
+    void TryCreateMap() {
+        if (!map_ && map_id_ && map_name_) {
+            map_.emplace(model::Map::Id{*map_id_}, *map_name_);
+        }
+    }
+
+    bool EndMap(json::error_code& ec) {
+        TryCreateMap();
+        if (!map_) {
+            return Fail(ec, "Map must have id and name"s);
+        }
+        // Объекты, встреченные до id и name карты, добавляются теперь, когда их количество известно
+        map_->Reserve(map_->GetRoads().size() + roads_.size(),
+                      map_->GetBuildings().size() + buildings_.size(),
+                      map_->GetOffices().size() + offices_.size());
+        for (const auto& road : roads_) {
+            map_->AddRoad(road);
+        }
+        for (const auto& building : buildings_) {
+            map_->AddBuilding(building);
+        }
+        try {
+            for (auto& office : offices_) {
+                map_->AddOffice(std::move(office));
+            }
+        } catch (const std::exception& ex) {
+            return Fail(ec, ex.what());
+        }
+        maps_.push_back(std::move(*map_));
+        map_.reset();
+        return true;
+    }
+
+    bool EndRoad(json::error_code& ec) {
+        if (!fields_.x0 || !fields_.y0 || (!fields_.x1 && !fields_.y1)) {
+            return Fail(ec, "Road must have x0, y0 and either x1 or y1"s);
+        }
+        const model::Point start{*fields_.x0, *fields_.y0};
+        const model::Road road = fields_.x1 ? model::Road{model::Road::HORIZONTAL, start, *fields_.x1}
+                                            : model::Road{model::Road::VERTICAL, start, *fields_.y1};
+        if (map_) {
+            map_->AddRoad(road);
+        } else {
+            roads_.push_back(road);
+        }
+        return true;
+    }
 
-        for (const auto& building_ : map_.at("buildings"s).as_array())
-        {
-            map.AddBuilding(GetBuilding(building_.as_object()));
+    bool EndBuilding(json::error_code& ec) {
+        if (!fields_.x || !fields_.y || !fields_.w || !fields_.h) {
+            return Fail(ec, "Building must have x, y, w and h"s);
+        }
+        const model::Building building{{{*fields_.x, *fields_.y}, {*fields_.w, *fields_.h}}};
+        if (map_) {
+            map_->AddBuilding(building);
+        } else {
+            buildings_.push_back(building);
         }
+        return true;
+    }
 
-        for (const auto& office_ : map_.at("offices"s).as_array())
-        {
-            map.AddOffice(GetOffice(office_.as_object()));
+    bool EndOffice(json::error_code& ec) {
+        if (!fields_.id || !fields_.x || !fields_.y || !fields_.offset_x || !fields_.offset_y) {
+            return Fail(ec, "Office must have id, x, y, offsetX and offsetY"s);
+        }
+        model::Office office{model::Office::Id{std::move(*fields_.id)},
+                             {*fields_.x, *fields_.y},
+                             {*fields_.offset_x, *fields_.offset_y}};
+        if (map_) {
+            try {
+                map_->AddOffice(std::move(office));
+            } catch (const std::exception& ex) {
+                return Fail(ec, ex.what());
+            }
+        } else {
+            offices_.push_back(std::move(office));
+        }
+        return true;
+    }
+
+    Root root_;
+    std::vector<model::Map>& maps_;
+    std::vector<Context> stack_;
+    std::string key_;
+    bool key_complete_ = false;
+    std::string string_;
+    bool string_complete_ = false;
+
+    Fields fields_;
+    std::optional<std::string> map_id_;
+    std::optional<std::string> map_name_;
+    std::optional<model::Map> map_;
+    std::vector<model::Road> roads_;
+    std::vector<model::Building> buildings_;
+    std::vector<model::Office> offices_;
+    std::string error_;
+};
+
+// Размер блока, которыми читается файл конфигурации
+constexpr size_t READ_BUFFER_SIZE = 64 * 1024;
+
+[[noreturn]] void ThrowLoadError(const std::filesystem::path& json_path, const std::string& error) {
+    throw std::invalid_argument("Failed to load "s + json_path.string() + ": "s + error);
+}
+
+// Передаёт parser очередную часть текста. more == false означает, что текст закончился
+void WriteToParser(json::basic_parser<ConfigHandler>& parser, bool more, const char* data, size_t size,
+                   const std::filesystem::path& json_path) {
+    json::error_code ec;
+    const size_t parsed = parser.write_some(more, data, size, ec);
+    if (ec) {
+        const std::string& error = parser.handler().GetError();
+        ThrowLoadError(json_path, error.empty() ? ec.message() : error);
+    }
+    if (parsed != size) {
+        ThrowLoadError(json_path, json::make_error_code(json::error::extra_data).message());
+    }
+}
+
+/*
+ * Разбирает поток in, передавая события обработчику parser.
+ * Выбрасывает std::invalid_argument с описанием ошибки
+ */
+void ParseStream(std::istream& in, json::basic_parser<ConfigHandler>& parser,
+                 const std::filesystem::path& json_path) {
+    std::vector<char> buffer(READ_BUFFER_SIZE);
+    while (in) {
+        in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        WriteToParser(parser, true, buffer.data(), static_cast<size_t>(in.gcount()), json_path);
+    }
+    WriteToParser(parser, false, nullptr, 0, json_path);
+}
+
+model::Map ParseMap(std::string_view text, const std::filesystem::path& json_path) {
+    std::vector<model::Map> maps;
+    json::basic_parser<ConfigHandler> parser{json::parse_options{}, ConfigHandler::Root::MAP, maps};
+    WriteToParser(parser, false, text.data(), text.size(), json_path);
+    return std::move(maps.front());
+}
+
+/*
+ * Сравнивает ключ raw_key в записи JSON, возможно с escape-последовательностями, со строкой
+ * name из символов ASCII. Некорректные последовательности считаются несовпадением:
+ * такой текст всё равно отвергнет разбор
+ */
+bool IsJsonKeyEqual(std::string_view raw_key, std::string_view name) {
+    size_t matched = 0;
+    for (size_t pos = 0; pos < raw_key.size(); ++pos) {
+        char c = raw_key[pos];
+        if (c == '\\') {
+            if (++pos >= raw_key.size()) {
+                return false;
+            }
+            switch (raw_key[pos]) {
+                case 'u': {
+                    unsigned code = 0;
+                    const char* hex = raw_key.data() + pos + 1;
+                    if (raw_key.size() - pos - 1 < 4
+                        || std::from_chars(hex, hex + 4, code, 16).ptr != hex + 4 || code > 0x7F) {
+                        return false;
+                    }
+                    c = static_cast<char>(code);
+                    pos += 4;
+                    break;
+                }
+                case 'b':
+                    c = '\b';
+                    break;
+                case 'f':
+                    c = '\f';
+                    break;
+                case 'n':
+                    c = '\n';
+                    break;
+                case 'r':
+                    c = '\r';
+                    break;
+                case 't':
+                    c = '\t';
+                    break;
+                default:
+                    c = raw_key[pos];
+                    break;
+            }
+        }
+        if (matched >= name.size() || name[matched] != c) {
+            return false;
+        }
+        ++matched;
+    }
+    return matched == name.size();
+}
+
+/*
+ * Находит в тексте конфигурации описания карт - объекты массива "maps" корневого объекта.
+ * Содержимое карт не разбирается, проверяется лишь парность скобок и кавычек,
+ * поэтому поиск намного быстрее разбора и не мешает распараллелить остальную работу.
+ * Остальной текст проверяет ValidateConfigWithoutMaps
+ */
+std::vector<std::string_view> SplitMaps(std::string_view text, const std::filesystem::path& json_path) {
+    std::vector<std::string_view> maps;
+    std::string brackets;     // Незакрытые скобки
+    std::string_view key;     // Последняя строка корневого объекта - ключ массива, если за ним следует '['
+    bool in_maps = false;     // Открыт ли массив maps корневого объекта
+    bool root_closed = false;
+    size_t map_begin = 0;
+
+    auto is_map_list_level = [&] {
+        return in_maps && brackets.size() == 2;
+    };
+
+    for (size_t pos = 0; pos < text.size(); ++pos) {
+        const char c = text[pos];
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            continue;
+        }
+        if (root_closed) {
+            ThrowLoadError(json_path, json::make_error_code(json::error::extra_data).message());
+        }
+        if (brackets.empty() && c != '{') {
+            ThrowLoadError(json_path, "Config must be an object"s);
+        }
+        if (is_map_list_level() && c != '{' && c != ',' && c != ']') {
+            ThrowLoadError(json_path, "Map description must be an object"s);
+        }
+
+        switch (c) {
+            case '"': {
+                const size_t begin = pos + 1;
+                for (++pos; pos < text.size() && text[pos] != '"'; ++pos) {
+                    if (text[pos] == '\\') {
+                        ++pos;
+                    }
+                }
+                if (pos >= text.size()) {
+                    ThrowLoadError(json_path, "Unterminated string"s);
+                }
+                if (brackets.size() == 1) {
+                    key = text.substr(begin, pos - begin);
+                }
+                break;
+            }
+            case '{':
+            case '[':
+                if (is_map_list_level()) {
+                    map_begin = pos;
+                } else if (brackets.size() == 1 && c == '[' && IsJsonKeyEqual(key, "maps"sv)) {
+                    in_maps = true;
+                }
+                brackets.push_back(c);
+                break;
+            case '}':
+            case ']':
+                if (brackets.empty() || brackets.back() != (c == '}' ? '{' : '[')) {
+                    ThrowLoadError(json_path, "Mismatched brackets"s);
+                }
+                brackets.pop_back();
+                if (is_map_list_level()) {
+                    maps.push_back(text.substr(map_begin, pos + 1 - map_begin));
+                } else if (in_maps && brackets.size() == 1) {
+                    in_maps = false;
+                }
+                root_closed = brackets.empty();
+                break;
+            default:
+                break;
+        }
+    }
+    if (!root_closed) {
+        ThrowLoadError(json_path, "Unexpected end of config"s);
+    }
+    return maps;
+}
+
+/*
+ * Разбирает конфигурацию, в которой описания карт map_texts (части text) заменены пустыми
+ * объектами, тем же обработчиком, что и последовательная загрузка. Так конфигурация
+ * принимается или отвергается одинаково при любом количестве потоков
+ */
+void ValidateConfigWithoutMaps(std::string_view text, const std::vector<std::string_view>& map_texts,
+                               const std::filesystem::path& json_path) {
+    std::string skeleton;
+    const char* pos = text.data();
+    for (std::string_view map_text : map_texts) {
+        skeleton.append(pos, map_text.data());
+        skeleton += "{}"sv;
+        pos = map_text.data() + map_text.size();
+    }
+    skeleton.append(pos, text.data() + text.size());
+
+    std::vector<model::Map> maps;
+    json::basic_parser<ConfigHandler> parser{json::parse_options{}, ConfigHandler::Root::CONFIG_WITHOUT_MAPS,
+                                             maps};
+    WriteToParser(parser, false, skeleton.data(), skeleton.size(), json_path);
+}
+
+}  // namespace
+
+model::Game LoadGame(const std::filesystem::path& json_path) {
+    std::ifstream file(json_path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Can't open JSON file "s + json_path.string());
+    }
+
+    // Файл читается блоками и разбирается потоково: дерево JSON и копия файла в памяти
+    // не создаются, объекты карт строятся сразу
+    std::vector<model::Map> maps;
+    json::basic_parser<ConfigHandler> parser{json::parse_options{}, ConfigHandler::Root::CONFIG, maps};
+    ParseStream(file, parser, json_path);
+
+    model::Game game;
+    for (auto& map : maps) {
+        game.AddMap(std::move(map));
+    }
+    return game;
+}
+
+model::Game LoadGame(const std::filesystem::path& json_path, unsigned thread_count) {
+    if (thread_count <= 1) {
+        return LoadGame(json_path);
+    }
+
+    std::ifstream file(json_path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Can't open JSON file "s + json_path.string());
+    }
+    const std::string text{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    const std::vector<std::string_view> map_texts = SplitMaps(text, json_path);
+    ValidateConfigWithoutMaps(text, map_texts, json_path);
+
+    // Каждая карта строится в своей задаче и кладётся на своё место,
+    // так что порядок карт и первая ошибка не зависят от планирования потоков
+    std::vector<std::optional<model::Map>> maps(map_texts.size());
+    std::vector<std::exception_ptr> errors(map_texts.size());
+    {
+        net::thread_pool pool{std::min<size_t>(thread_count, map_texts.size())};
+        for (size_t i = 0; i < map_texts.size(); ++i) {
+            net::post(pool, [&, i] {
+                try {
+                    maps[i].emplace(ParseMap(map_texts[i], json_path));
+                } catch (...) {
+                    errors[i] = std::current_exception();
+                }
+            });
+        }
+        pool.join();
+    }
+
+    model::Game game;
+    for (size_t i = 0; i < maps.size(); ++i) {
+        if (errors[i]) {
+            std::rethrow_exception(errors[i]);
         }
-    
-        game.AddMap(map);
+        game.AddMap(std::move(*maps[i]));
     }
     return game;
 }
@@ -15,6 +15,16 @@ model::Building GetBuilding(const json::object& buildingCords);
 
 model::Office GetOffice(const json::object& officeCords);
 
+// Разбирает файл потоково, блоками фиксированного размера, не держа в памяти ни текст файла, ни дерево JSON
 model::Game LoadGame(const std::filesystem::path& json_path);
 
+/*
+ * Загружает игру, строя карты из массива "maps" параллельно на thread_count потоках.
+ * В отличие от потоковой загрузки, читает файл в память целиком.
+ * Карты добавляются в игру в порядке их описания в файле, а конфигурация принимается
+ * или отвергается так же, как при потоковой загрузке.
+ * При thread_count <= 1 равносильна LoadGame(json_path)
+ */
+model::Game LoadGame(const std::filesystem::path& json_path, unsigned thread_count);
+
 }  // namespace json_loader
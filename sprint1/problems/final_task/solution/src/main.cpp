@@ -1,11 +1,13 @@
 #include "sdk.h"
 //
-#include <boost/asio/signal_set.hpp>
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/signal_set.hpp>
 #include <iostream>
+#include <memory>
+#include <optional>
 #include <thread>
 
-#include "json_loader.h"
+#include "config_reloader.h"
 #include "request_handler.h"
 
 using namespace std::literals;
@@ -27,19 +29,50 @@ void RunWorkers(unsigned n, const Fn& fn) {
     fn();
 }
 
+struct Args {
+    std::filesystem::path config_path;
+    unsigned load_threads = 1;
+};
+
+// Возвращает std::nullopt, если аргументы не соответствуют формату вызова
+std::optional<Args> ParseCommandLine(int argc, const char* argv[]) {
+    Args args;
+    int i = 1;
+    if (argc == 4 && argv[1] == "--load-threads"sv) {
+        try {
+            const int load_threads = std::stoi(argv[2]);
+            if (load_threads < 1) {
+                return std::nullopt;
+            }
+            args.load_threads = static_cast<unsigned>(load_threads);
+        } catch (const std::exception&) {
+            return std::nullopt;
+        }
+        i = 3;
+    }
+    if (argc != i + 1) {
+        return std::nullopt;
+    }
+    args.config_path = argv[i];
+    return args;
+}
+
 }  // namespace
 
 int main(int argc, const char* argv[]) {
-    if (argc != 2) {
-        std::cerr << "Usage: game_server <game-config-json>"sv << std::endl;
+    const auto args = ParseCommandLine(argc, argv);
+    if (!args) {
+        std::cerr << "Usage: game_server [--load-threads <n>] <game-config-json | maps-bin>"sv << std::endl;
         return EXIT_FAILURE;
     }
     try {
+        const unsigned num_threads = std::thread::hardware_concurrency();
+
         // 1. Загружаем карту из файла и построить модель игры
-        model::Game game = json_loader::LoadGame(argv[1]);
+        const std::filesystem::path& config_path = args->config_path;
+        auto game = std::make_shared<const model::Game>(config_reloader::LoadGameFile(config_path, args->load_threads));
 
         // 2. Инициализируем io_context
-        const unsigned num_threads = std::thread::hardware_concurrency();
         net::io_context ioc(num_threads);
 
         // 3. Добавляем асинхронный обработчик сигналов SIGINT и SIGTERM
@@ -51,14 +84,17 @@ int main(int argc, const char* argv[]) {
         });
 
         // 4. Создаём обработчик HTTP-запросов и связываем его с моделью игры
-        http_handler::RequestHandler handler{game};
+        http_handler::RequestHandler handler{std::move(game)};
+
+        // По SIGHUP файл карт перечитывается без перезапуска сервера
+        config_reloader::ConfigReloader reloader{ioc, config_path, args->load_threads, handler};
 
         // 5. Запустить обработчик HTTP-запросов, делегируя их обработчику запросов
         const auto address = net::ip::make_address("0.0.0.0");
         constexpr net::ip::port_type port = 8080;
         http_server::ServeHttp(ioc, {address, port}, [&handler](auto&& req, auto&& send) {
             handler(std::forward<decltype(req)>(req), std::forward<decltype(send)>(send));
-        });        
+        });
 
         // Эта надпись сообщает тестам о том, что сервер запущен и готов обрабатывать запросы
         std::cout << "Server has started..."sv << std::endl;
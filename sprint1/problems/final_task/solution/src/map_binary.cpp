@@ -0,0 +1,404 @@
+#include "map_binary.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <bit>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+namespace map_binary {
+
+using namespace std::literals;
+
+namespace {
+
+// Дороги и здания используются прямо из файла, поэтому их представление в памяти
+// должно совпадать с записями файла: четыре 64-битных числа без выравнивающих байтов
+static_assert(std::is_trivially_copyable_v<model::Road> && std::is_standard_layout_v<model::Road>);
+static_assert(std::is_trivially_copyable_v<model::Building>
+              && std::is_standard_layout_v<model::Building>);
+static_assert(sizeof(model::Road) == 4 * sizeof(int64_t));
+static_assert(sizeof(model::Building) == 4 * sizeof(int64_t));
+static_assert(sizeof(model::Dimension) == sizeof(int64_t));
+
+constexpr char MAGIC[4] = {'G', 'M', 'A', 'P'};
+
+struct StringRef {
+    uint64_t offset;
+    uint64_t size;
+};
+
+struct ArrayRef {
+    uint64_t offset;
+    uint64_t count;
+};
+
+struct Header {
+    char magic[4];
+    uint32_t version;
+    uint64_t map_count;
+    uint64_t maps_offset;
+    StringRef strings;
+};
+
+struct MapEntry {
+    StringRef id;
+    StringRef name;
+    ArrayRef roads;
+    ArrayRef road_length_prefix_sums;
+    ArrayRef buildings;
+    ArrayRef offices;
+};
+
+struct OfficeRecord {
+    StringRef id;
+    int64_t x;
+    int64_t y;
+    int64_t offset_x;
+    int64_t offset_y;
+};
+
+void CheckHostByteOrder() {
+    if constexpr (std::endian::native != std::endian::little) {
+        throw std::runtime_error("Binary map format requires a little-endian host");
+    }
+}
+
+/*
+ * Файл, отображённый в память только для чтения
+ */
+class MappedFile {
+public:
+    explicit MappedFile(const std::filesystem::path& path) {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "Failed to open "s + path.string());
+        }
+        struct stat st {};
+        if (::fstat(fd, &st) != 0) {
+            const int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), "Failed to stat "s + path.string());
+        }
+        size_ = static_cast<size_t>(st.st_size);
+        if (size_ > 0) {
+            void* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED) {
+                const int error = errno;
+                ::close(fd);
+                throw std::system_error(error, std::generic_category(), "Failed to map "s + path.string());
+            }
+            data_ = static_cast<const std::byte*>(data);
+        }
+        // Отображение остаётся действительным и после закрытия файла
+        ::close(fd);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+        if (data_) {
+            ::munmap(const_cast<std::byte*>(data_), size_);
+        }
+    }
+
+    const std::byte* GetData() const noexcept {
+        return data_;
+    }
+
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+private:
+    const std::byte* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+/*
+ * Проверяет, что разделы лежат внутри файла и выровнены, и выдаёт их как массивы
+ */
+class FileView {
+public:
+    explicit FileView(const MappedFile& file) noexcept
+        : data_{file.GetData()}
+        , size_{file.GetSize()} {
+    }
+
+    template <typename T>
+    std::span<const T> GetArray(uint64_t offset, uint64_t count) const {
+        if (offset % alignof(T) != 0 || offset > size_ || count > (size_ - offset) / sizeof(T)) {
+            throw std::runtime_error("Binary map file is damaged");
+        }
+        return {reinterpret_cast<const T*>(data_ + offset), static_cast<size_t>(count)};
+    }
+
+    template <typename T>
+    std::span<const T> GetArray(ArrayRef ref) const {
+        return GetArray<T>(ref.offset, ref.count);
+    }
+
+    std::string_view GetString(const Header& header, StringRef ref) const {
+        const auto strings = GetArray<char>(header.strings.offset, header.strings.size);
+        if (ref.offset > strings.size() || ref.size > strings.size() - ref.offset) {
+            throw std::runtime_error("Binary map file is damaged");
+        }
+        return {strings.data() + ref.offset, static_cast<size_t>(ref.size)};
+    }
+
+private:
+    const std::byte* data_;
+    size_t size_;
+};
+
+/*
+ * Собирает содержимое файла в памяти
+ */
+class FileBuilder {
+public:
+    template <typename T>
+    ArrayRef AppendArray(std::span<const T> values) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        Align();
+        const ArrayRef ref{data_.size(), values.size()};
+        data_.append(reinterpret_cast<const char*>(values.data()), values.size_bytes());
+        return ref;
+    }
+
+    StringRef AddString(std::string_view str) {
+        const StringRef ref{strings_.size(), str.size()};
+        strings_ += str;
+        return ref;
+    }
+
+    template <typename T>
+    void Write(uint64_t offset, const T& value) {
+        std::memcpy(data_.data() + offset, &value, sizeof(value));
+    }
+
+    // Дописывает таблицу строк и возвращает её расположение
+    StringRef AppendStrings() {
+        Align();
+        const StringRef ref{data_.size(), strings_.size()};
+        data_ += strings_;
+        return ref;
+    }
+
+    // Выделяет место под size байт, которые будут заполнены позже, и возвращает его смещение
+    uint64_t Allocate(size_t size) {
+        Align();
+        const uint64_t offset = data_.size();
+        data_.resize(data_.size() + size);
+        return offset;
+    }
+
+    size_t GetSize() const noexcept {
+        return data_.size();
+    }
+
+    const std::string& GetData() const noexcept {
+        return data_;
+    }
+
+private:
+    void Align() {
+        data_.resize((data_.size() + 7) / 8 * 8);
+    }
+
+    std::string data_;
+    std::string strings_;
+};
+
+[[noreturn]] void ThrowSystemError(const std::string& what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+// Записывает data в новый файл с уникальным именем рядом с path и дожидается его
+// сохранения на диск. Возвращает имя файла
+std::filesystem::path WriteTempFile(const std::filesystem::path& path, std::string_view data) {
+    std::string temp_path = path.string() + ".XXXXXX"s;
+    const int fd = ::mkstemp(temp_path.data());
+    if (fd < 0) {
+        ThrowSystemError("Failed to create temporary file for "s + path.string());
+    }
+    try {
+        // mkstemp создаёт файл, доступный только владельцу, а карты читает сервер
+        if (::fchmod(fd, 0644) != 0) {
+            ThrowSystemError("Failed to set permissions of "s + temp_path);
+        }
+        size_t written_total = 0;
+        while (written_total < data.size()) {
+            const ssize_t written = ::write(fd, data.data() + written_total, data.size() - written_total);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                ThrowSystemError("Failed to write "s + temp_path);
+            }
+            written_total += static_cast<size_t>(written);
+        }
+        if (::fsync(fd) != 0) {
+            ThrowSystemError("Failed to sync "s + temp_path);
+        }
+    } catch (...) {
+        ::close(fd);
+        ::unlink(temp_path.c_str());
+        throw;
+    }
+    if (::close(fd) != 0) {
+        const int error = errno;
+        ::unlink(temp_path.c_str());
+        errno = error;
+        ThrowSystemError("Failed to close "s + temp_path);
+    }
+    return temp_path;
+}
+
+// Сохраняет на диск запись каталога dir, в том числе переименования в нём
+void SyncDirectory(const std::filesystem::path& dir) {
+    const int fd = ::open(dir.empty() ? "." : dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) {
+        ThrowSystemError("Failed to open directory "s + dir.string());
+    }
+    const int result = ::fsync(fd);
+    const int error = errno;
+    ::close(fd);
+    if (result != 0) {
+        errno = error;
+        ThrowSystemError("Failed to sync directory "s + dir.string());
+    }
+}
+
+/*
+ * Проверяет дороги карты из файла: поиск позиции на дорогах (Map::GetRoadPosition)
+ * полагается на то, что каждая дорога горизонтальна или вертикальна, а префиксные суммы
+ * равны суммам длин дорог и потому не убывают
+ */
+void CheckRoads(std::span<const model::Road> roads, std::span<const model::Dimension> prefix_sums) {
+    const auto fail = [] {
+        throw std::runtime_error("Binary map file is damaged");
+    };
+    if (roads.size() != prefix_sums.size()) {
+        fail();
+    }
+    model::Dimension total_length = 0;
+    for (size_t i = 0; i < roads.size(); ++i) {
+        const model::Point start = roads[i].GetStart();
+        const model::Point end = roads[i].GetEnd();
+        const bool is_horizontal = start.y == end.y;
+        if (!is_horizontal && start.x != end.x) {
+            fail();
+        }
+        // Длина считается с проверкой переполнения: координаты в файле могут быть любыми
+        model::Dimension length = 0;
+        if (is_horizontal ? __builtin_sub_overflow(end.x, start.x, &length)
+                          : __builtin_sub_overflow(end.y, start.y, &length)) {
+            fail();
+        }
+        if (length == std::numeric_limits<model::Dimension>::min()) {
+            fail();
+        }
+        if (__builtin_add_overflow(total_length, length < 0 ? -length : length, &total_length)
+            || prefix_sums[i] != total_length) {
+            fail();
+        }
+    }
+}
+
+}  // namespace
+
+void SaveGame(const model::Game& game, const std::filesystem::path& path) {
+    CheckHostByteOrder();
+
+    const auto& maps = game.GetMaps();
+    FileBuilder builder;
+    builder.Allocate(sizeof(Header));
+    const uint64_t maps_offset = builder.Allocate(sizeof(MapEntry) * maps.size());
+
+    for (size_t i = 0; i < maps.size(); ++i) {
+        const model::Map& map = maps[i];
+        MapEntry entry{};
+        entry.id = builder.AddString(*map.GetId());
+        entry.name = builder.AddString(map.GetName());
+        entry.roads = builder.AppendArray(map.GetRoads());
+        entry.road_length_prefix_sums = builder.AppendArray(map.GetRoadLengthPrefixSums());
+        entry.buildings = builder.AppendArray(map.GetBuildings());
+
+        std::vector<OfficeRecord> offices;
+        offices.reserve(map.GetOffices().size());
+        for (const model::Office& office : map.GetOffices()) {
+            offices.push_back({builder.AddString(*office.GetId()), office.GetPosition().x,
+                               office.GetPosition().y, office.GetOffset().dx, office.GetOffset().dy});
+        }
+        entry.offices = builder.AppendArray(std::span<const OfficeRecord>{offices});
+        builder.Write(maps_offset + i * sizeof(MapEntry), entry);
+    }
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = FORMAT_VERSION;
+    header.map_count = maps.size();
+    header.maps_offset = maps_offset;
+    header.strings = builder.AppendStrings();
+    builder.Write(0, header);
+
+    // Сервер может держать старый файл отображённым в память. Перезапись файла на месте
+    // обрезала бы его под сервером (SIGBUS при обращении к картам), поэтому новый файл
+    // пишется рядом и подменяет старый переименованием: старое отображение остаётся целым.
+    // Файл сохраняется на диск до переименования, а каталог - после, чтобы после сбоя
+    // на месте path оказался либо старый, либо новый файл целиком
+    const std::filesystem::path temp_path = WriteTempFile(path, builder.GetData());
+    try {
+        std::filesystem::rename(temp_path, path);
+    } catch (...) {
+        std::error_code ec;
+        std::filesystem::remove(temp_path, ec);
+        throw;
+    }
+    SyncDirectory(path.parent_path());
+}
+
+model::Game LoadGame(const std::filesystem::path& path) {
+    CheckHostByteOrder();
+
+    auto file = std::make_shared<const MappedFile>(path);
+    const FileView view{*file};
+
+    const auto header_bytes = view.GetArray<Header>(0, 1);
+    const Header& header = header_bytes.front();
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error(path.string() + " is not a binary map file"s);
+    }
+    if (header.version != FORMAT_VERSION) {
+        throw std::runtime_error("Unsupported binary map version "s + std::to_string(header.version));
+    }
+
+    model::Game game;
+    for (const MapEntry& entry : view.GetArray<MapEntry>(header.maps_offset, header.map_count)) {
+        model::Map map{model::Map::Id{std::string{view.GetString(header, entry.id)}},
+                       std::string{view.GetString(header, entry.name)}};
+        const auto roads = view.GetArray<model::Road>(entry.roads);
+        const auto prefix_sums = view.GetArray<model::Dimension>(entry.road_length_prefix_sums);
+        CheckRoads(roads, prefix_sums);
+        map.SetMappedGeometry(file, roads, prefix_sums, view.GetArray<model::Building>(entry.buildings));
+        // Офисов на карте немного, а их идентификаторы нужно индексировать, поэтому они копируются
+        for (const OfficeRecord& office : view.GetArray<OfficeRecord>(entry.offices)) {
+            map.AddOffice({model::Office::Id{std::string{view.GetString(header, office.id)}},
+                           {office.x, office.y},
+                           {office.offset_x, office.offset_y}});
+        }
+        game.AddMap(std::move(map));
+    }
+    return game;
+}
+
+}  // namespace map_binary
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <filesystem>
+
+#include "model.h"
+
+namespace map_binary {
+
+/*
+ * Скомпилированный файл карт.
+ * Все числа - 64-битные little-endian, все разделы выровнены на 8 байт:
+ *   заголовок:  "GMAP", версия (uint32), количество карт, смещение таблицы карт,
+ *               смещение и размер таблицы строк;
+ *   таблица карт: для каждой карты - id и название (смещение и длина в таблице строк),
+ *               смещения и количества дорог, префиксных сумм длин дорог, зданий и офисов;
+ *   массивы дорог {x0, y0, x1, y1}, префиксных сумм, зданий {x, y, w, h}
+ *   и офисов {id, x, y, offsetX, offsetY};
+ *   таблица строк.
+ * Дороги, здания и префиксные суммы при загрузке не копируются: карта ссылается
+ * прямо на отображённый в память файл. Дороги и префиксные суммы лишь проверяются
+ * одним проходом, так как на них полагается поиск позиции на дорогах.
+ */
+inline constexpr uint32_t FORMAT_VERSION = 1;
+
+// Записывает карты игры во временный файл с уникальным именем рядом с path, сохраняет его
+// на диск и переименовывает в path. Процессы, отобразившие в память прежний файл path,
+// продолжают работать со старыми картами, а после сбоя path содержит старый или новый файл
+void SaveGame(const model::Game& game, const std::filesystem::path& path);
+
+// Отображает файл path в память и строит по нему модель игры.
+// Выбрасывает std::runtime_error, если файл повреждён, в том числе если дорога
+// не горизонтальна и не вертикальна или префиксные суммы не совпадают с длинами дорог
+model::Game LoadGame(const std::filesystem::path& path);
+
+}  // namespace map_binary
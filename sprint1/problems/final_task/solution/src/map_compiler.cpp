@@ -0,0 +1,25 @@
+// Преобразует конфигурационный файл игры в двоичный файл карт (см. map_binary.h),
+// который game_server загружает без разбора JSON
+
+#include <cstdlib>
+#include <iostream>
+
+#include "json_loader.h"
+#include "map_binary.h"
+
+using namespace std::literals;
+
+int main(int argc, const char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "Usage: map_compiler <game-config-json> <output-maps-bin>"sv << std::endl;
+        return EXIT_FAILURE;
+    }
+    try {
+        const model::Game game = json_loader::LoadGame(argv[1]);
+        map_binary::SaveGame(game, argv[2]);
+        std::cout << "Compiled "sv << game.GetMaps().size() << " maps to "sv << argv[2] << std::endl;
+    } catch (const std::exception& ex) {
+        std::cerr << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -1,10 +1,84 @@
 #include "model.h"
 
+#include <algorithm>
+#include <cmath>
 #include <stdexcept>
 
 namespace model {
 using namespace std::literals;
 
+void Map::AddRoad(const Road& road) {
+    if (mapped_geometry_) {
+        throw std::logic_error("Map "s + *id_ + " geometry is read-only"s);
+    }
+    const Dimension total_length = GetTotalRoadLength();
+    roads_.emplace_back(road);
+    try {
+        road_length_prefix_sums_.push_back(total_length + road.GetLength());
+    } catch (...) {
+        roads_.pop_back();
+        throw;
+    }
+}
+
+void Map::AddBuilding(const Building& building) {
+    if (mapped_geometry_) {
+        throw std::logic_error("Map "s + *id_ + " geometry is read-only"s);
+    }
+    buildings_.emplace_back(building);
+}
+
+void Map::Reserve(size_t road_count, size_t building_count, size_t office_count) {
+    if (!mapped_geometry_) {
+        roads_.reserve(road_count);
+        road_length_prefix_sums_.reserve(road_count);
+        buildings_.reserve(building_count);
+    }
+    offices_.reserve(office_count);
+    warehouse_id_to_index_.reserve(office_count);
+}
+
+void Map::SetMappedGeometry(std::shared_ptr<const void> storage, Roads roads,
+                            std::span<const Dimension> road_length_prefix_sums, Buildings buildings) {
+    if (roads.size() != road_length_prefix_sums.size()) {
+        throw std::invalid_argument("Road length prefix sums do not match roads");
+    }
+    mapped_geometry_ = std::move(storage);
+    mapped_roads_ = roads;
+    mapped_road_length_prefix_sums_ = road_length_prefix_sums;
+    mapped_buildings_ = buildings;
+    roads_.clear();
+    road_length_prefix_sums_.clear();
+    buildings_.clear();
+}
+
+RoadPosition Map::GetRoadPosition(double fraction) const {
+    const Roads roads = GetRoads();
+    const auto prefix_sums = GetRoadLengthPrefixSums();
+    if (roads.empty()) {
+        throw std::logic_error("Map "s + *id_ + " has no roads"s);
+    }
+
+    const Dimension total_length = GetTotalRoadLength();
+    if (total_length == 0) {
+        // Все дороги вырождены в точки - выбираем любую с равной вероятностью
+        const auto road_index = static_cast<size_t>(fraction * static_cast<double>(roads.size()));
+        return {std::min(road_index, roads.size() - 1), 0.0};
+    }
+
+    // distance строго меньше суммарной длины, даже если fraction при вычислениях округлился до 1
+    const double max_distance = std::nextafter(static_cast<double>(total_length), 0.0);
+    const double distance = std::clamp(fraction * static_cast<double>(total_length), 0.0, max_distance);
+    // Первая дорога, конец которой дальше distance. Дороги нулевой длины не выбираются никогда
+    const auto it = std::upper_bound(prefix_sums.begin(), prefix_sums.end(), distance,
+                                     [](double value, Dimension prefix_sum) {
+                                         return value < static_cast<double>(prefix_sum);
+                                     });
+    const auto road_index = static_cast<size_t>(it - prefix_sums.begin());
+    const Dimension road_start = prefix_sums[road_index] - roads[road_index].GetLength();
+    return {road_index, distance - static_cast<double>(road_start)};
+}
+
 void Map::AddOffice(Office office) {
     if (warehouse_id_to_index_.contains(office.GetId())) {
         throw std::invalid_argument("Duplicate warehouse");
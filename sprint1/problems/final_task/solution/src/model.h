@@ -1,4 +1,6 @@
 #pragma once
+#include <memory>
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -66,11 +68,23 @@ public:
         return end_;
     }
 
+    Dimension GetLength() const noexcept {
+        // Дорога горизонтальная или вертикальная, так что одно из слагаемых равно нулю
+        const Dimension length = end_.x - start_.x + end_.y - start_.y;
+        return length >= 0 ? length : -length;
+    }
+
 private:
     Point start_;
     Point end_;
 };
 
+// Точка на дороге: номер дороги в Map::GetRoads и расстояние от её начала
+struct RoadPosition {
+    size_t road_index;
+    double offset;
+};
+
 class Building {
 public:
     explicit Building(Rectangle bounds) noexcept
@@ -116,8 +130,9 @@ private:
 class Map {
 public:
     using Id = util::Tagged<std::string, Map>;
-    using Roads = std::vector<Road>;
-    using Buildings = std::vector<Building>;
+    // Дороги и здания лежат либо в самой карте, либо в отображённом в память файле карт
+    using Roads = std::span<const Road>;
+    using Buildings = std::span<const Building>;
     using Offices = std::vector<Office>;
 
     Map(Id id, std::string name) noexcept
@@ -133,35 +148,68 @@ public:
         return name_;
     }
 
-    const Buildings& GetBuildings() const noexcept {
-        return buildings_;
+    Buildings GetBuildings() const noexcept {
+        return mapped_geometry_ ? mapped_buildings_ : Buildings{buildings_};
     }
 
-    const Roads& GetRoads() const noexcept {
-        return roads_;
+    Roads GetRoads() const noexcept {
+        return mapped_geometry_ ? mapped_roads_ : Roads{roads_};
     }
 
     const Offices& GetOffices() const noexcept {
         return offices_;
     }
 
-    void AddRoad(const Road& road) {
-        roads_.emplace_back(road);
+    // AddRoad и AddBuilding выбрасывают std::logic_error для карты с отображённой геометрией
+    void AddRoad(const Road& road);
+
+    Dimension GetTotalRoadLength() const noexcept {
+        const auto prefix_sums = GetRoadLengthPrefixSums();
+        return prefix_sums.empty() ? 0 : prefix_sums.back();
     }
 
-    void AddBuilding(const Building& building) {
-        buildings_.emplace_back(building);
+    // prefix_sums[i] - суммарная длина дорог с номерами 0..i
+    std::span<const Dimension> GetRoadLengthPrefixSums() const noexcept {
+        return mapped_geometry_ ? mapped_road_length_prefix_sums_
+                                : std::span<const Dimension>{road_length_prefix_sums_};
     }
 
+    /*
+     * Переводит число fraction из [0, 1) в точку на дорогах карты так, что при равномерно
+     * распределённом fraction точка равномерно распределена по суммарной длине дорог.
+     * Работает за O(log n) от количества дорог.
+     * Выбрасывает std::logic_error, если на карте нет дорог
+     */
+    RoadPosition GetRoadPosition(double fraction) const;
+
+    void AddBuilding(const Building& building);
+
     void AddOffice(Office office);
 
+    // Заранее выделяет память под объекты карты, количество которых известно
+    void Reserve(size_t road_count, size_t building_count, size_t office_count);
+
+    /*
+     * Делает карту представлением массивов, лежащих в storage, без копирования.
+     * storage продлевает жизнь хранилища (например, отображённого в память файла)
+     * на время жизни карты и её копий
+     */
+    void SetMappedGeometry(std::shared_ptr<const void> storage, Roads roads,
+                           std::span<const Dimension> road_length_prefix_sums, Buildings buildings);
+
 private:
     using OfficeIdToIndex = std::unordered_map<Office::Id, size_t, util::TaggedHasher<Office::Id>>;
 
     Id id_;
     std::string name_;
-    Roads roads_;
-    Buildings buildings_;
+    std::vector<Road> roads_;
+    std::vector<Dimension> road_length_prefix_sums_;
+    std::vector<Building> buildings_;
+
+    std::shared_ptr<const void> mapped_geometry_;
+    Roads mapped_roads_;
+    std::span<const Dimension> mapped_road_length_prefix_sums_;
+    Buildings mapped_buildings_;
 
     OfficeIdToIndex warehouse_id_to_index_;
     Offices offices_;
@@ -1,8 +1,30 @@
 #include "request_handler.h"
 
+#include <utility>
+
 namespace http_handler {
 
-    void RequestHandler::SetResponceStatus(const std::string requestTarget, http::status& status) {
+    MapResponses::MapResponses(std::shared_ptr<const model::Game> game)
+        : game_{std::move(game)}
+        , maps_body_{MakeAllMapsInfo(*game_)} {
+        map_bodies_.reserve(game_->GetMaps().size());
+        for (const auto& map : game_->GetMaps()) {
+            map_bodies_.emplace(*map.GetId(), MakeMapInfo(map));
+        }
+    }
+
+    void RequestHandler::SetGame(std::shared_ptr<const model::Game> game) {
+        auto responses = std::make_shared<const MapResponses>(std::move(game));
+        std::shared_ptr<const MapResponses> old_responses;
+        {
+            std::lock_guard lock{mutex_};
+            old_responses = std::exchange(responses_, std::move(responses));
+        }
+        // Если старую модель никто не использует, она удаляется здесь, вне блокировки
+    }
+
+    void RequestHandler::SetResponceStatus(const MapResponses& responses, const std::string requestTarget,
+                                           http::status& status) {
         if (requestTarget.find("/api/v1/") != 0) {
             status = http::status::bad_request;
         }
@@ -12,9 +34,7 @@ namespace http_handler {
                 status = http::status::ok;
             }
             else {
-                model::Map::Id id{ mapId };
-                auto requested_map = game_.FindMap(id);
-                if (requested_map != NULL) {
+                if (responses.FindMapBody(mapId) != nullptr) {
                     status = http::status::ok;
                 }
                 else {
@@ -37,21 +57,20 @@ namespace http_handler {
         body = json::serialize(obj);
     }
 
-    void RequestHandler::AddAllMapsInfo(std::string& body) {
-        auto maps = game_.GetMaps();
+    std::string MapResponses::MakeAllMapsInfo(const model::Game& game) {
         json::array jsonArr;
-        for (auto map : maps) {
+        for (const auto& map : game.GetMaps()) {
             json::object mapObj;
             mapObj["id"] = *map.GetId();
             mapObj["name"] = map.GetName();
             jsonArr.push_back(mapObj);
         }
-        body = json::serialize(jsonArr);
+        return json::serialize(jsonArr);
     }
 
-    void RequestHandler::AddRoadsInfo(const model::Map* map, json::object& object) {
+    void MapResponses::AddRoadsInfo(const model::Map& map, json::object& object) {
         json::array jsonArr;
-        for (auto road : map->GetRoads()) {
+        for (auto road : map.GetRoads()) {
             model::Point start = road.GetStart();
             json::object tempObj;
             tempObj["x0"] = start.x;
@@ -67,9 +86,9 @@ namespace http_handler {
         object["roads"] = jsonArr;
     }
 
-    void RequestHandler::AddBuildingsInfo(const model::Map* map, json::object& object) {
+    void MapResponses::AddBuildingsInfo(const model::Map& map, json::object& object) {
         json::array jsonArr;
-        for (auto building : map->GetBuildings()) {
+        for (auto building : map.GetBuildings()) {
             model::Rectangle bound = building.GetBounds();
             json::object tempObj;
             tempObj["x"] = bound.position.x;
@@ -81,9 +100,9 @@ namespace http_handler {
         object["buildings"] = jsonArr;
     }
 
-    void RequestHandler::AddOfficesInfo(const model::Map* map, json::object& object) {
+    void MapResponses::AddOfficesInfo(const model::Map& map, json::object& object) {
         json::array jsonArr;
-        for (auto office : map->GetOffices()) {
+        for (auto office : map.GetOffices()) {
             json::object tempObj;
             tempObj["id"] = *office.GetId();
             tempObj["x"] = office.GetPosition().x;
@@ -95,23 +114,20 @@ namespace http_handler {
         object["offices"] = jsonArr;
     }
 
-    void RequestHandler::AddMapInfo(std::string& body, std::string& mapId) {
-        model::Map::Id id{ mapId };
-        auto requested_map = game_.FindMap(id);
-        if (requested_map != NULL) {
-            json::object obj;
-            obj["id"] = *requested_map->GetId();
-            obj["name"] = requested_map->GetName();
+    std::string MapResponses::MakeMapInfo(const model::Map& map) {
+        json::object obj;
+        obj["id"] = *map.GetId();
+        obj["name"] = map.GetName();
 
-            AddRoadsInfo(requested_map, obj);
-            AddBuildingsInfo(requested_map, obj);
-            AddOfficesInfo(requested_map, obj);
+        AddRoadsInfo(map, obj);
+        AddBuildingsInfo(map, obj);
+        AddOfficesInfo(map, obj);
 
-            body = json::serialize(obj);
-        }
+        return json::serialize(obj);
     }
 
-    void RequestHandler::MakeStringBody(const http::status status, std::string& body, std::string& mapId) {
+    void RequestHandler::MakeStringBody(const MapResponses& responses, const http::status status,
+                                        std::string& body, std::string& mapId) {
         if (status == http::status::bad_request) {
             CreateErrorResponce(body, "badRequest", "Bad request");
         }
@@ -120,21 +136,23 @@ namespace http_handler {
         }
         else if (status == http::status::ok) {
             if (mapId == "maps"sv) {
-                AddAllMapsInfo(body);
+                body = responses.GetMapsBody();
             }
-            else {
-                AddMapInfo(body, mapId);
+            else if (auto map_body = responses.FindMapBody(mapId)) {
+                body = *map_body;
             }
         }
     }
 
     StringResponse RequestHandler::MakeStringResponce(const std::string requestTarget, unsigned http_version, bool isKeepAlive) {
 
+        // Весь запрос обрабатывается с одной версией модели, даже если её подменят
+        const auto responses = GetResponses();
         http::status status;
         std::string body;
-        SetResponceStatus(requestTarget, status);
+        SetResponceStatus(*responses, requestTarget, status);
         std::string mapId = GetMapIdFromRequestTarget(requestTarget);
-        MakeStringBody(status, body, mapId);
+        MakeStringBody(*responses, status, body, mapId);
 
         StringResponse response(status, http_version);
         response.set(http::field::content_type, ContentType::APP_JSON);
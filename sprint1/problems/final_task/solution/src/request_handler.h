@@ -2,6 +2,10 @@
 #include "http_server.h"
 #include "model.h"
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <boost/json.hpp>
 
 namespace http_handler {
@@ -22,32 +26,69 @@ struct ContentType {
     // При необходимости внутрь ContentType можно добавить и другие типы контента
 };
 
-class RequestHandler {
+/*
+ * Модель игры вместе с заранее сформированными по ней телами ответов API карт.
+ * После создания не меняется, поэтому читается из разных потоков без блокировок
+ */
+class MapResponses {
 public:
-    explicit RequestHandler(model::Game& game)
-        : game_{game} {
+    explicit MapResponses(std::shared_ptr<const model::Game> game);
+
+    const model::Game& GetGame() const noexcept {
+        return *game_;
     }
 
-    RequestHandler(const RequestHandler&) = delete;
-    RequestHandler& operator=(const RequestHandler&) = delete;
+    const std::string& GetMapsBody() const noexcept {
+        return maps_body_;
+    }
 
-    std::string GetMapIdFromRequestTarget(const std::string requestTarget);
+    // Возвращает nullptr, если карты map_id нет
+    const std::string* FindMapBody(const std::string& map_id) const noexcept {
+        if (auto it = map_bodies_.find(map_id); it != map_bodies_.end()) {
+            return &it->second;
+        }
+        return nullptr;
+    }
 
-    void SetResponceStatus(const std::string requestTarget, http::status& status);
+private:
+    static std::string MakeAllMapsInfo(const model::Game& game);
 
-    void CreateErrorResponce(std::string& body, const std::string& code, const std::string& message);
+    static void AddRoadsInfo(const model::Map& map, json::object& object);
+
+    static void AddBuildingsInfo(const model::Map& map, json::object& object);
+
+    static void AddOfficesInfo(const model::Map& map, json::object& object);
+
+    static std::string MakeMapInfo(const model::Map& map);
 
-    void AddAllMapsInfo(std::string& body);
+    std::shared_ptr<const model::Game> game_;
+    std::string maps_body_;
+    std::unordered_map<std::string, std::string> map_bodies_;
+};
+
+class RequestHandler {
+public:
+    explicit RequestHandler(std::shared_ptr<const model::Game> game)
+        : responses_{std::make_shared<const MapResponses>(std::move(game))} {
+    }
+
+    RequestHandler(const RequestHandler&) = delete;
+    RequestHandler& operator=(const RequestHandler&) = delete;
 
-    void AddRoadsInfo(const model::Map* map, json::object& object);
+    /*
+     * Подменяет модель игры для новых запросов. Тела ответов строятся в вызывающем потоке
+     * до подмены. Запросы, начатые раньше, дообрабатываются со старой моделью
+     */
+    void SetGame(std::shared_ptr<const model::Game> game);
 
-    void AddBuildingsInfo(const model::Map* map, json::object& object);
+    std::string GetMapIdFromRequestTarget(const std::string requestTarget);
 
-    void AddOfficesInfo(const model::Map* map, json::object& object);
+    void SetResponceStatus(const MapResponses& responses, const std::string requestTarget, http::status& status);
 
-    void AddMapInfo(std::string& body, std::string& mapId);
+    void CreateErrorResponce(std::string& body, const std::string& code, const std::string& message);
 
-    void MakeStringBody(const http::status status, std::string& body, std::string& mapId);
+    void MakeStringBody(const MapResponses& responses, const http::status status, std::string& body,
+                        std::string& mapId);
 
     StringResponse MakeStringResponce(const std::string requestTarget, unsigned http_version, bool isKeepAlive);
 
@@ -61,7 +102,14 @@ public:
     }
 
 private:
-    model::Game& game_;
+    std::shared_ptr<const MapResponses> GetResponses() const {
+        std::lock_guard lock{mutex_};
+        return responses_;
+    }
+
+    // Защищает лишь указатель: сами ответы не меняются
+    mutable std::mutex mutex_;
+    std::shared_ptr<const MapResponses> responses_;
 };
 
 }  // namespace http_handler
@@ -0,0 +1,88 @@
+#include <catch2/catch_test_macros.hpp>
+#include <csignal>
+#include <filesystem>
+#include <memory>
+#include <optional>
+
+#include "../src/config_reloader.h"
+#include "../src/map_binary.h"
+#include "temp_dir.h"
+
+using namespace model;
+using namespace std::literals;
+using test_util::TempDir;
+namespace http = boost::beast::http;
+namespace net = boost::asio;
+
+namespace {
+
+Game MakeGame(const std::string& map_id, Coord road_length) {
+    Map map{Map::Id{map_id}, "Map "s + map_id};
+    map.AddRoad({Road::HORIZONTAL, {0, 0}, road_length});
+    map.AddOffice({Office::Id{"o0"s}, {0, 0}, {1, 1}});
+    Game game;
+    game.AddMap(std::move(map));
+    return game;
+}
+
+bool HasMap(http_handler::RequestHandler& handler, const std::string& map_id) {
+    return handler.MakeStringResponce("/api/v1/maps/"s + map_id, 11, false).result() == http::status::ok;
+}
+
+}  // namespace
+
+SCENARIO("Game config reloading") {
+    TempDir dir{"config-reloader-tests"s};
+    const auto path = dir.path / "maps.bin"s;
+
+    GIVEN("a server running with a compiled maps file") {
+        map_binary::SaveGame(MakeGame("old"s, 10), path);
+        auto game = std::make_shared<const Game>(config_reloader::LoadGameFile(path, 1));
+        const std::shared_ptr<const Game> old_game = game;
+        http_handler::RequestHandler handler{std::move(game)};
+
+        net::io_context ioc;
+        std::optional<config_reloader::ConfigReloader> reloader;
+        reloader.emplace(ioc, path, 1, handler);
+        REQUIRE(HasMap(handler, "old"s));
+
+        // Доставляет SIGHUP и дожидается окончания перезагрузки:
+        // при разрушении загрузчик завершает поставленную в очередь загрузку
+        const auto reload = [&] {
+            std::raise(SIGHUP);
+            ioc.poll();
+            reloader.reset();
+        };
+
+        WHEN("map_compiler replaces the file and the server gets SIGHUP") {
+            map_binary::SaveGame(MakeGame("new"s, 20), path);
+            reload();
+
+            THEN("new requests see the new maps") {
+                CHECK(HasMap(handler, "new"s));
+                CHECK_FALSE(HasMap(handler, "old"s));
+            }
+
+            THEN("the old model stays readable") {
+                REQUIRE(old_game->GetMaps().size() == 1);
+                const Map& map = old_game->GetMaps()[0];
+                CHECK(*map.GetId() == "old"s);
+                CHECK(map.GetRoads()[0].GetEnd().x == 10);
+                CHECK(map.GetTotalRoadLength() == 10);
+            }
+        }
+
+        WHEN("the new file is broken") {
+            const auto broken_path = dir.path / "broken.bin"s;
+            map_binary::SaveGame(MakeGame("new"s, 20), broken_path);
+            std::filesystem::resize_file(broken_path, std::filesystem::file_size(broken_path) / 2);
+            std::filesystem::rename(broken_path, path);
+            reload();
+
+            THEN("the server keeps the old maps") {
+                CHECK(HasMap(handler, "old"s));
+                CHECK_FALSE(HasMap(handler, "new"s));
+            }
+        }
+    }
+}
@@ -0,0 +1,116 @@
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include "../src/json_loader.h"
+#include "temp_dir.h"
+
+using namespace model;
+using namespace std::literals;
+using test_util::TempDir;
+
+namespace {
+
+constexpr unsigned PARALLEL_THREADS = 4;
+
+const std::string TOWN_MAP = R"({"id": "town", "name": "Town",
+    "roads": [{"x0": 0, "y0": 0, "x1": 40}, {"x0": 40, "y0": 0, "y1": 30}],
+    "buildings": [{"x": 5, "y": 5, "w": 30, "h": 20}],
+    "offices": [{"id": "o0", "x": 40, "y": 30, "offsetX": 5, "offsetY": 0}]})";
+
+const std::string VILLAGE_MAP = R"({"id": "village", "name": "Village",
+    "roads": [{"x0": 0, "y0": 0, "y1": 10}], "buildings": [], "offices": []})";
+
+void WriteFile(const std::filesystem::path& path, const std::string& text) {
+    std::ofstream out{path, std::ios::binary};
+    out << text;
+}
+
+}  // namespace
+
+SCENARIO("JSON config loading") {
+    TempDir dir{"json-loader-tests"s};
+    const auto path = dir.path / "config.json"s;
+
+    GIVEN("a valid config with several maps and extra root fields") {
+        WriteFile(path, R"({"defaultDogSpeed": 1.5, "extra": {"maps": [1, 2]}, "maps": [)"s + TOWN_MAP + ", "s
+                            + VILLAGE_MAP + R"(], "lootGenerator": {"period": 5}})"s);
+
+        WHEN("it is loaded by the streaming and the parallel loaders") {
+            const Game streamed = json_loader::LoadGame(path);
+            const Game parallel = json_loader::LoadGame(path, PARALLEL_THREADS);
+
+            THEN("both give the same maps in the same order") {
+                REQUIRE(streamed.GetMaps().size() == 2);
+                REQUIRE(parallel.GetMaps().size() == 2);
+                for (size_t i = 0; i < streamed.GetMaps().size(); ++i) {
+                    const Map& s = streamed.GetMaps()[i];
+                    const Map& p = parallel.GetMaps()[i];
+                    CHECK(s.GetId() == p.GetId());
+                    CHECK(s.GetName() == p.GetName());
+                    CHECK(s.GetRoads().size() == p.GetRoads().size());
+                    CHECK(s.GetBuildings().size() == p.GetBuildings().size());
+                    CHECK(s.GetOffices().size() == p.GetOffices().size());
+                    CHECK(s.GetTotalRoadLength() == p.GetTotalRoadLength());
+                }
+                CHECK(*streamed.GetMaps()[0].GetId() == "town"s);
+                CHECK(*streamed.GetMaps()[1].GetId() == "village"s);
+            }
+        }
+    }
+
+    GIVEN("a config whose maps key is written with escapes") {
+        WriteFile(path, R"({"ma\u0070s": [)"s + TOWN_MAP + ", "s + VILLAGE_MAP + "]}"s);
+
+        WHEN("it is loaded by the streaming and the parallel loaders") {
+            const Game streamed = json_loader::LoadGame(path);
+            const Game parallel = json_loader::LoadGame(path, PARALLEL_THREADS);
+
+            THEN("both find the maps") {
+                CHECK(streamed.GetMaps().size() == 2);
+                CHECK(parallel.GetMaps().size() == 2);
+            }
+        }
+    }
+
+    GIVEN("configs broken outside the maps") {
+        const std::string maps = TOWN_MAP + ", "s + VILLAGE_MAP;
+        const std::string broken_configs[] = {
+            R"({"maps" [)"s + maps + "]}"s,
+            R"({"maps": [)"s + maps + "]} garbage"s,
+            R"({"maps": [)"s + maps + "],}"s,
+            R"({"maps": [)"s + maps + "]"s,
+            "["s + maps + "]"s,
+            R"({"maps": 5})"s,
+        };
+
+        THEN("both loaders reject each of them") {
+            for (const auto& config : broken_configs) {
+                WriteFile(path, config);
+                CHECK_THROWS_AS(json_loader::LoadGame(path), std::invalid_argument);
+                CHECK_THROWS_AS(json_loader::LoadGame(path, PARALLEL_THREADS), std::invalid_argument);
+            }
+        }
+    }
+
+    GIVEN("configs with a broken map") {
+        const std::string broken_configs[] = {
+            R"({"maps": [)"s + TOWN_MAP + ", 5]}"s,
+            R"({"maps": [)"s + TOWN_MAP + R"(, {"id": "x", "name": "X", "roads": [{"x0": 0}]}]})"s,
+            R"({"maps": [{"id": "x", "name": "X", "roads": [1], "buildings": [], "offices": []}]})"s,
+            R"({"maps": [{"id": "x", "name": "X", "roads": [], "buildings": ["b"], "offices": []}]})"s,
+            R"({"maps": [{"id": "x", "name": "X", "roads": [], "buildings": [], "offices": [[1]]}]})"s,
+            R"({"maps": [{"id": "x", "name": "X", "roads": {}, "buildings": [], "offices": []}]})"s,
+        };
+
+        THEN("both loaders reject each of them") {
+            for (const auto& config : broken_configs) {
+                WriteFile(path, config);
+                CHECK_THROWS_AS(json_loader::LoadGame(path), std::invalid_argument);
+                CHECK_THROWS_AS(json_loader::LoadGame(path, PARALLEL_THREADS), std::invalid_argument);
+            }
+        }
+    }
+}
@@ -0,0 +1,179 @@
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <stdexcept>
+
+#include "../src/map_binary.h"
+#include "temp_dir.h"
+
+using namespace model;
+using namespace std::literals;
+using test_util::TempDir;
+
+namespace {
+
+Map MakeMap(const std::string& id, Coord road_count) {
+    Map map{Map::Id{id}, "Map "s + id};
+    for (Coord i = 0; i < road_count; ++i) {
+        map.AddRoad({Road::HORIZONTAL, {0, i * 10}, 40});
+        map.AddRoad({Road::VERTICAL, {i * 10, 0}, 30 + i});
+        map.AddBuilding(Building{{{i * 10 + 1, 1}, {3, 4}}});
+    }
+    map.AddOffice({Office::Id{id + "-o1"s}, {0, 0}, {5, -3}});
+    map.AddOffice({Office::Id{id + "-o2"s}, {10, 10}, {-1, 2}});
+    return map;
+}
+
+void CheckSameMaps(const Map& lhs, const Map& rhs) {
+    CHECK(lhs.GetId() == rhs.GetId());
+    CHECK(lhs.GetName() == rhs.GetName());
+
+    REQUIRE(lhs.GetRoads().size() == rhs.GetRoads().size());
+    for (size_t i = 0; i < lhs.GetRoads().size(); ++i) {
+        const Road& l = lhs.GetRoads()[i];
+        const Road& r = rhs.GetRoads()[i];
+        CHECK((l.GetStart().x == r.GetStart().x && l.GetStart().y == r.GetStart().y));
+        CHECK((l.GetEnd().x == r.GetEnd().x && l.GetEnd().y == r.GetEnd().y));
+    }
+    CHECK(std::ranges::equal(lhs.GetRoadLengthPrefixSums(), rhs.GetRoadLengthPrefixSums()));
+
+    REQUIRE(lhs.GetBuildings().size() == rhs.GetBuildings().size());
+    for (size_t i = 0; i < lhs.GetBuildings().size(); ++i) {
+        const Rectangle& l = lhs.GetBuildings()[i].GetBounds();
+        const Rectangle& r = rhs.GetBuildings()[i].GetBounds();
+        CHECK((l.position.x == r.position.x && l.position.y == r.position.y));
+        CHECK((l.size.width == r.size.width && l.size.height == r.size.height));
+    }
+
+    REQUIRE(lhs.GetOffices().size() == rhs.GetOffices().size());
+    for (size_t i = 0; i < lhs.GetOffices().size(); ++i) {
+        const Office& l = lhs.GetOffices()[i];
+        const Office& r = rhs.GetOffices()[i];
+        CHECK(l.GetId() == r.GetId());
+        CHECK((l.GetPosition().x == r.GetPosition().x && l.GetPosition().y == r.GetPosition().y));
+        CHECK((l.GetOffset().dx == r.GetOffset().dx && l.GetOffset().dy == r.GetOffset().dy));
+    }
+}
+
+// Заменяет в файле path первое вхождение последовательности 64-битных чисел from на to
+void PatchFile(const std::filesystem::path& path, std::initializer_list<int64_t> from,
+               std::initializer_list<int64_t> to) {
+    std::string data;
+    {
+        std::ifstream in{path, std::ios::binary};
+        data.assign(std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{});
+    }
+    const std::string from_bytes(reinterpret_cast<const char*>(std::data(from)), from.size() * sizeof(int64_t));
+    const std::string to_bytes(reinterpret_cast<const char*>(std::data(to)), to.size() * sizeof(int64_t));
+    const size_t pos = data.find(from_bytes);
+    REQUIRE(pos != std::string::npos);
+    data.replace(pos, to_bytes.size(), to_bytes);
+    std::ofstream out{path, std::ios::binary | std::ios::trunc};
+    out << data;
+}
+
+}  // namespace
+
+SCENARIO("Binary map file") {
+    TempDir dir{"map-binary-tests"s};
+    const auto path = dir.path / "maps.bin"s;
+
+    GIVEN("a game with several maps") {
+        Game game;
+        game.AddMap(MakeMap("map1"s, 3));
+        game.AddMap(MakeMap("town"s, 50));
+        game.AddMap(Map{Map::Id{"empty"s}, "Empty"s});
+
+        WHEN("it is saved and loaded back") {
+            map_binary::SaveGame(game, path);
+            const Game loaded = map_binary::LoadGame(path);
+
+            THEN("the maps are the same") {
+                REQUIRE(loaded.GetMaps().size() == game.GetMaps().size());
+                for (size_t i = 0; i < game.GetMaps().size(); ++i) {
+                    CheckSameMaps(loaded.GetMaps()[i], game.GetMaps()[i]);
+                }
+                CHECK(loaded.FindMap(Map::Id{"town"s}) == &loaded.GetMaps()[1]);
+                CHECK(loaded.GetMaps()[1].GetTotalRoadLength() == game.GetMaps()[1].GetTotalRoadLength());
+            }
+
+            AND_WHEN("the file is overwritten while the loaded game is in use") {
+                Game smaller;
+                smaller.AddMap(MakeMap("map2"s, 1));
+                map_binary::SaveGame(smaller, path);
+
+                THEN("the loaded game still sees the old maps") {
+                    CheckSameMaps(loaded.GetMaps()[1], game.GetMaps()[1]);
+                }
+
+                THEN("loading the file gives the new maps") {
+                    const Game reloaded = map_binary::LoadGame(path);
+                    REQUIRE(reloaded.GetMaps().size() == 1);
+                    CheckSameMaps(reloaded.GetMaps()[0], smaller.GetMaps()[0]);
+                }
+
+                THEN("no temporary file is left") {
+                    CHECK(std::distance(std::filesystem::directory_iterator{dir.path},
+                                        std::filesystem::directory_iterator{})
+                          == 1);
+                }
+            }
+        }
+
+        WHEN("a road in a saved file is neither horizontal nor vertical") {
+            Game small;
+            Map map{Map::Id{"m"s}, "M"s};
+            map.AddRoad({Road::HORIZONTAL, {1001, 2002}, 1041});
+            small.AddMap(std::move(map));
+            map_binary::SaveGame(small, path);
+            PatchFile(path, {1001, 2002, 1041, 2002}, {1001, 2002, 1041, 2003});
+
+            THEN("loading fails") {
+                CHECK_THROWS_AS(map_binary::LoadGame(path), std::runtime_error);
+            }
+        }
+
+        WHEN("road length prefix sums in a saved file do not match the roads") {
+            Game small;
+            Map map{Map::Id{"m"s}, "M"s};
+            map.AddRoad({Road::HORIZONTAL, {1001, 2002}, 1041});
+            map.AddRoad({Road::VERTICAL, {1041, 2002}, 2032});
+            small.AddMap(std::move(map));
+            map_binary::SaveGame(small, path);
+            REQUIRE_NOTHROW(map_binary::LoadGame(path));
+            PatchFile(path, {40, 70}, {50, 70});
+
+            THEN("loading fails") {
+                CHECK_THROWS_AS(map_binary::LoadGame(path), std::runtime_error);
+            }
+        }
+
+        WHEN("a road in a saved file is long enough to overflow the prefix sums") {
+            Game small;
+            Map map{Map::Id{"m"s}, "M"s};
+            map.AddRoad({Road::HORIZONTAL, {1001, 2002}, 1041});
+            small.AddMap(std::move(map));
+            map_binary::SaveGame(small, path);
+            const int64_t min = std::numeric_limits<int64_t>::min();
+            PatchFile(path, {1001, 2002, 1041, 2002}, {min, 2002, 1041, 2002});
+
+            THEN("loading fails") {
+                CHECK_THROWS_AS(map_binary::LoadGame(path), std::runtime_error);
+            }
+        }
+
+        WHEN("a saved file is truncated") {
+            map_binary::SaveGame(game, path);
+            std::filesystem::resize_file(path, std::filesystem::file_size(path) / 2);
+
+            THEN("loading fails") {
+                CHECK_THROWS_AS(map_binary::LoadGame(path), std::runtime_error);
+            }
+        }
+    }
+}
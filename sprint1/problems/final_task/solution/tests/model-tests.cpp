@@ -0,0 +1,91 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <stdexcept>
+
+#include "../src/model.h"
+
+using namespace model;
+using namespace std::literals;
+
+namespace {
+
+// Горизонтальные дороги заданных длин, идущие друг за другом
+Map MakeMap(std::initializer_list<Dimension> road_lengths) {
+    Map map{Map::Id{"map1"s}, "Map 1"s};
+    Coord x = 0;
+    for (Dimension length : road_lengths) {
+        map.AddRoad({Road::HORIZONTAL, {x, 0}, x + length});
+        x += length;
+    }
+    return map;
+}
+
+}  // namespace
+
+SCENARIO("Sampling points on map roads") {
+    GIVEN("a map without roads") {
+        const Map map{Map::Id{"empty"s}, "Empty"s};
+
+        THEN("no point can be sampled") {
+            CHECK_THROWS_AS(map.GetRoadPosition(0.5), std::logic_error);
+        }
+    }
+
+    GIVEN("a map with roads of lengths 10 and 30") {
+        const Map map = MakeMap({10, 30});
+        REQUIRE(map.GetTotalRoadLength() == 40);
+
+        THEN("roads are chosen in proportion to their lengths") {
+            constexpr int sample_count = 4000;
+            int first_road_count = 0;
+            for (int i = 0; i < sample_count; ++i) {
+                const RoadPosition position = map.GetRoadPosition(static_cast<double>(i) / sample_count);
+                const Dimension length = map.GetRoads()[position.road_index].GetLength();
+                CHECK(position.offset >= 0.0);
+                CHECK(position.offset < static_cast<double>(length));
+                first_road_count += position.road_index == 0 ? 1 : 0;
+            }
+            CHECK(first_road_count == sample_count / 4);
+        }
+
+        THEN("the offset is measured from the start of the chosen road") {
+            const RoadPosition position = map.GetRoadPosition(0.5);
+            CHECK(position.road_index == 1);
+            CHECK(position.offset == 10.0);
+        }
+
+        THEN("fraction close to 1 stays on the last road") {
+            for (double fraction : {std::nextafter(1.0, 0.0), 1.0}) {
+                const RoadPosition position = map.GetRoadPosition(fraction);
+                CHECK(position.road_index == 1);
+                CHECK(position.offset < 30.0);
+            }
+        }
+    }
+
+    GIVEN("a map with zero-length roads among others") {
+        const Map map = MakeMap({0, 10, 0, 5, 0});
+
+        THEN("zero-length roads are never chosen") {
+            for (double fraction : {0.0, 0.3, 2.0 / 3.0, 0.9, std::nextafter(1.0, 0.0)}) {
+                const RoadPosition position = map.GetRoadPosition(fraction);
+                CHECK(map.GetRoads()[position.road_index].GetLength() > 0);
+            }
+            CHECK(map.GetRoadPosition(0.0).road_index == 1);
+            CHECK(map.GetRoadPosition(2.0 / 3.0).road_index == 3);
+            CHECK(map.GetRoadPosition(std::nextafter(1.0, 0.0)).road_index == 3);
+        }
+    }
+
+    GIVEN("a map where every road has zero length") {
+        const Map map = MakeMap({0, 0, 0, 0});
+
+        THEN("roads are chosen evenly") {
+            CHECK(map.GetRoadPosition(0.0).road_index == 0);
+            CHECK(map.GetRoadPosition(0.3).road_index == 1);
+            CHECK(map.GetRoadPosition(0.6).road_index == 2);
+            CHECK(map.GetRoadPosition(std::nextafter(1.0, 0.0)).road_index == 3);
+            CHECK(map.GetRoadPosition(0.6).offset == 0.0);
+        }
+    }
+}
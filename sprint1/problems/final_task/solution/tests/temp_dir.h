@@ -0,0 +1,27 @@
+#pragma once
+
+#include <filesystem>
+#include <random>
+#include <string>
+
+namespace test_util {
+
+// Временный каталог с уникальным именем, который удаляется вместе со всем содержимым
+struct TempDir {
+    explicit TempDir(const std::string& prefix)
+        : path{std::filesystem::temp_directory_path()
+               / (prefix + '-' + std::to_string(std::random_device{}()))} {
+        std::filesystem::create_directories(path);
+    }
+
+    TempDir(const TempDir&) = delete;
+    TempDir& operator=(const TempDir&) = delete;
+
+    ~TempDir() {
+        std::filesystem::remove_all(path);
+    }
+
+    std::filesystem::path path;
+};
+
+}  // namespace test_util
@@ -0,0 +1,129 @@
+#include "collision_batch.h"
+
+#include <cassert>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define COLLISION_DETECTOR_HAS_AVX2_KERNEL 1
+#include <immintrin.h>
+#endif
+
+namespace collision_detector {
+
+namespace detail {
+
+// Формулы и порядок операций повторяют TryCollectPoint, чтобы результаты совпадали бит в бит
+void CollectPointsScalar(geom::Point2D a, geom::Point2D b, double gatherer_width,
+                         const ItemsSoA& items, std::vector<BatchHit>& hits) {
+    const double v_x = b.x - a.x;
+    const double v_y = b.y - a.y;
+    const double v_len2 = v_x * v_x + v_y * v_y;
+    for (size_t i = 0; i < items.size(); ++i) {
+        const double u_x = items.x[i] - a.x;
+        const double u_y = items.y[i] - a.y;
+        const double u_dot_v = u_x * v_x + u_y * v_y;
+        const double u_len2 = u_x * u_x + u_y * u_y;
+        const double proj_ratio = u_dot_v / v_len2;
+        const double sq_distance = u_len2 - (u_dot_v * u_dot_v) / v_len2;
+        const double radius = gatherer_width + items.width[i];
+        if (proj_ratio >= 0 && proj_ratio <= 1 && sq_distance <= radius * radius) {
+            hits.push_back({i, sq_distance, proj_ratio});
+        }
+    }
+}
+
+#ifdef COLLISION_DETECTOR_HAS_AVX2_KERNEL
+
+bool HasAvx2() noexcept {
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    return has_avx2;
+}
+
+// FMA не используется: слитые умножение и сложение округляют иначе, чем скалярный код
+__attribute__((target("avx2"))) void CollectPointsAvx2(geom::Point2D a, geom::Point2D b,
+                                                       double gatherer_width, const ItemsSoA& items,
+                                                       std::vector<BatchHit>& hits) {
+    constexpr size_t LANES = 4;
+
+    const double v_x = b.x - a.x;
+    const double v_y = b.y - a.y;
+    const double v_len2 = v_x * v_x + v_y * v_y;
+
+    const __m256d a_x4 = _mm256_set1_pd(a.x);
+    const __m256d a_y4 = _mm256_set1_pd(a.y);
+    const __m256d v_x4 = _mm256_set1_pd(v_x);
+    const __m256d v_y4 = _mm256_set1_pd(v_y);
+    const __m256d v_len2_4 = _mm256_set1_pd(v_len2);
+    const __m256d gatherer_width4 = _mm256_set1_pd(gatherer_width);
+    const __m256d zero4 = _mm256_setzero_pd();
+    const __m256d one4 = _mm256_set1_pd(1.0);
+
+    const size_t count = items.size();
+    size_t i = 0;
+    for (; i + LANES <= count; i += LANES) {
+        const __m256d u_x = _mm256_sub_pd(_mm256_loadu_pd(items.x.data() + i), a_x4);
+        const __m256d u_y = _mm256_sub_pd(_mm256_loadu_pd(items.y.data() + i), a_y4);
+        const __m256d u_dot_v = _mm256_add_pd(_mm256_mul_pd(u_x, v_x4), _mm256_mul_pd(u_y, v_y4));
+        const __m256d u_len2 = _mm256_add_pd(_mm256_mul_pd(u_x, u_x), _mm256_mul_pd(u_y, u_y));
+        const __m256d proj_ratio = _mm256_div_pd(u_dot_v, v_len2_4);
+        const __m256d sq_distance
+            = _mm256_sub_pd(u_len2, _mm256_div_pd(_mm256_mul_pd(u_dot_v, u_dot_v), v_len2_4));
+        const __m256d radius = _mm256_add_pd(gatherer_width4, _mm256_loadu_pd(items.width.data() + i));
+
+        const __m256d collected = _mm256_and_pd(
+            _mm256_and_pd(_mm256_cmp_pd(proj_ratio, zero4, _CMP_GE_OQ),
+                          _mm256_cmp_pd(proj_ratio, one4, _CMP_LE_OQ)),
+            _mm256_cmp_pd(sq_distance, _mm256_mul_pd(radius, radius), _CMP_LE_OQ));
+        int mask = _mm256_movemask_pd(collected);
+        if (mask == 0) {
+            continue;
+        }
+
+        alignas(32) double proj_ratios[LANES];
+        alignas(32) double sq_distances[LANES];
+        _mm256_store_pd(proj_ratios, proj_ratio);
+        _mm256_store_pd(sq_distances, sq_distance);
+        while (mask != 0) {
+            const int lane = __builtin_ctz(mask);
+            hits.push_back({i + lane, sq_distances[lane], proj_ratios[lane]});
+            mask &= mask - 1;
+        }
+    }
+
+    // Оставшиеся предметы обрабатываем скалярным кодом
+    if (i < count) {
+        const size_t first_hit = hits.size();
+        const ItemsSoA tail{items.x.subspan(i), items.y.subspan(i), items.width.subspan(i)};
+        CollectPointsScalar(a, b, gatherer_width, tail, hits);
+        for (size_t hit = first_hit; hit < hits.size(); ++hit) {
+            hits[hit].index += i;
+        }
+    }
+}
+
+#else
+
+bool HasAvx2() noexcept {
+    return false;
+}
+
+void CollectPointsAvx2(geom::Point2D a, geom::Point2D b, double gatherer_width,
+                       const ItemsSoA& items, std::vector<BatchHit>& hits) {
+    CollectPointsScalar(a, b, gatherer_width, items, hits);
+}
+
+#endif
+
+}  // namespace detail
+
+void CollectPointsBatch(geom::Point2D a, geom::Point2D b, double gatherer_width, const ItemsSoA& items,
+                        std::vector<BatchHit>& hits) {
+    assert(b.x != a.x || b.y != a.y);
+    assert(items.y.size() == items.size() && items.width.size() == items.size());
+    if (detail::HasAvx2()) {
+        detail::CollectPointsAvx2(a, b, gatherer_width, items, hits);
+    } else {
+        detail::CollectPointsScalar(a, b, gatherer_width, items, hits);
+    }
+}
+
+}  // namespace collision_detector
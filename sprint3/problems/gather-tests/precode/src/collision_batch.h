@@ -0,0 +1,51 @@
+#pragma once
+
+#include "geom.h"
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace collision_detector {
+
+// Предметы в виде структуры массивов: i-й предмет - (x[i], y[i]) шириной width[i]
+struct ItemsSoA {
+    std::span<const double> x;
+    std::span<const double> y;
+    std::span<const double> width;
+
+    size_t size() const noexcept {
+        return x.size();
+    }
+};
+
+struct BatchHit {
+    // индекс предмета в ItemsSoA
+    size_t index;
+    double sq_distance;
+    double proj_ratio;
+};
+
+/*
+ * Пакетный аналог TryCollectPoint: проверяет все предметы items для собирателя,
+ * движущегося из a в b, и дописывает в hits подобранные предметы в порядке индексов.
+ * Результаты совпадают с TryCollectPoint(a, b, c).IsCollected(gatherer_width + width) бит в бит,
+ * если библиотека собрана без слияния операций в FMA (-ffp-contract=off, см. CMakeLists.txt).
+ * Перемещение должно быть ненулевым.
+ * Если процессор поддерживает AVX2, предметы обрабатываются по 4 за раз.
+ */
+void CollectPointsBatch(geom::Point2D a, geom::Point2D b, double gatherer_width, const ItemsSoA& items,
+                        std::vector<BatchHit>& hits);
+
+namespace detail {
+
+// Реализации, между которыми выбирает CollectPointsBatch. Открыты для тестов
+void CollectPointsScalar(geom::Point2D a, geom::Point2D b, double gatherer_width,
+                         const ItemsSoA& items, std::vector<BatchHit>& hits);
+bool HasAvx2() noexcept;
+void CollectPointsAvx2(geom::Point2D a, geom::Point2D b, double gatherer_width,
+                       const ItemsSoA& items, std::vector<BatchHit>& hits);
+
+}  // namespace detail
+
+}  // namespace collision_detector
@@ -1,5 +1,16 @@
 #include "collision_detector.h"
 
+#include "collision_batch.h"
+#include "item_index.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <exception>
+#include <thread>
+#include <unordered_map>
+
 namespace collision_detector {
 
 CollectionResult TryCollectPoint(geom::Point2D a, geom::Point2D b, geom::Point2D c) {
@@ -21,11 +32,231 @@ CollectionResult TryCollectPoint(geom::Point2D a, geom::Point2D b, geom::Point2D
     return CollectionResult(sq_distance, proj_ratio);
 }
 
-// В задании на разработку тестов реализовывать следующую функцию не нужно -
-// она будет линковаться извне.
+namespace {
+
 /*
+ * Равномерная сетка, в ячейки которой разложены предметы.
+ * Собиратель проверяется только с предметами из ячеек, которые пересекает
+ * ограничивающий прямоугольник его перемещения, расширенный на радиус сбора.
+ * Координаты предметов хранятся структурой массивов, упорядоченной по ячейкам,
+ * так что предметы каждой ячейки проверяются одним пакетом.
+ */
+class ItemGrid {
+public:
+    ItemGrid(std::span<const Item> items, double cell_size)
+        : cell_size_{cell_size} {
+        const size_t items_count = items.size();
+        std::vector<std::pair<detail::CellKey, size_t>> item_cells;
+        item_cells.reserve(items_count);
+        for (size_t i = 0; i < items_count; ++i) {
+            item_cells.emplace_back(detail::GetCell(items[i].position, cell_size_), i);
+        }
+        std::sort(item_cells.begin(), item_cells.end());
+
+        x_.reserve(items_count);
+        y_.reserve(items_count);
+        width_.reserve(items_count);
+        ids_.reserve(items_count);
+        for (size_t pos = 0; pos < item_cells.size(); ++pos) {
+            const auto& [cell, item_id] = item_cells[pos];
+            if (pos == 0 || !(item_cells[pos - 1].first == cell)) {
+                cells_.emplace(cell, CellRange{pos, pos});
+            }
+            ++cells_.at(cell).end;
+            const Item& item = items[item_id];
+            x_.push_back(item.position.x);
+            y_.push_back(item.position.y);
+            width_.push_back(item.width);
+            ids_.push_back(item_id);
+        }
+    }
+
+    /*
+     * Для каждой ячейки, которая может пересекаться с прямоугольником, вызывает
+     * fn(items, ids): предметы ячейки и их исходные номера
+     */
+    template <typename Fn>
+    void ForEachCandidateCell(double min_x, double min_y, double max_x, double max_y, Fn&& fn) const {
+        detail::ForEachCellInBox(cells_, detail::GetCell({min_x, min_y}, cell_size_),
+                                 detail::GetCell({max_x, max_y}, cell_size_), [this, &fn](CellRange range) {
+                                     VisitRange(range, fn);
+                                 });
+    }
+
+private:
+    // Предметы ячейки занимают позиции [begin, end) в x_, y_, width_ и ids_
+    struct CellRange {
+        size_t begin;
+        size_t end;
+    };
+
+    template <typename Fn>
+    void VisitRange(CellRange range, Fn& fn) const {
+        const size_t count = range.end - range.begin;
+        const ItemsSoA items{std::span{x_}.subspan(range.begin, count),
+                             std::span{y_}.subspan(range.begin, count),
+                             std::span{width_}.subspan(range.begin, count)};
+        fn(items, std::span{ids_}.subspan(range.begin, count));
+    }
+
+    double cell_size_;
+    std::vector<double> x_;
+    std::vector<double> y_;
+    std::vector<double> width_;
+    std::vector<size_t> ids_;
+    std::unordered_map<detail::CellKey, CellRange, detail::CellKeyHasher> cells_;
+};
+
+// Размер ячейки сетки выбирается равным наибольшему радиусу сбора:
+// тогда собиратель, стоящий на месте, проверяет не больше 3x3 ячеек
+double ChooseCellSize(std::span<const Gatherer> gatherers, double max_item_width) {
+    double max_gatherer_width = 0.0;
+    for (const Gatherer& gatherer : gatherers) {
+        max_gatherer_width = std::max(max_gatherer_width, gatherer.width);
+    }
+    constexpr double MIN_CELL_SIZE = 1e-3;
+    return std::max(max_item_width + max_gatherer_width, MIN_CELL_SIZE);
+}
+
+double GetMaxItemWidth(std::span<const Item> items) {
+    double max_item_width = 0.0;
+    for (const Item& item : items) {
+        max_item_width = std::max(max_item_width, item.width);
+    }
+    return max_item_width;
+}
+
+// Дописывает в events события собирателей с номерами [first_gatherer, last_gatherer).
+// Grid - ItemGrid или ItemIndex
+template <typename Grid>
+void CollectEvents(const Grid& grid, double max_item_width, std::span<const Gatherer> gatherers,
+                   size_t first_gatherer, size_t last_gatherer, std::vector<GatheringEvent>& events) {
+    std::vector<BatchHit> hits;
+    for (size_t gatherer_id = first_gatherer; gatherer_id < last_gatherer; ++gatherer_id) {
+        const Gatherer& gatherer = gatherers[gatherer_id];
+        // Собиратель, не сдвинувшийся с места, ничего не подбирает
+        if (gatherer.start_pos.x == gatherer.end_pos.x && gatherer.start_pos.y == gatherer.end_pos.y) {
+            continue;
+        }
+
+        const double reach = gatherer.width + max_item_width;
+        grid.ForEachCandidateCell(
+            std::min(gatherer.start_pos.x, gatherer.end_pos.x) - reach,
+            std::min(gatherer.start_pos.y, gatherer.end_pos.y) - reach,
+            std::max(gatherer.start_pos.x, gatherer.end_pos.x) + reach,
+            std::max(gatherer.start_pos.y, gatherer.end_pos.y) + reach,
+            [&](const ItemsSoA& cell_items, std::span<const size_t> ids) {
+                hits.clear();
+                CollectPointsBatch(gatherer.start_pos, gatherer.end_pos, gatherer.width, cell_items, hits);
+                for (const BatchHit& hit : hits) {
+                    events.push_back({ids[hit.index], gatherer_id, hit.sq_distance, hit.proj_ratio});
+                }
+            });
+    }
+}
+
+// Пара (gatherer_id, item_id) у каждого события своя, поэтому порядок полный
+// и не зависит ни от раскладки предметов по ячейкам, ни от распределения работы по потокам
+bool EventLess(const GatheringEvent& lhs, const GatheringEvent& rhs) {
+    if (lhs.time != rhs.time) {
+        return lhs.time < rhs.time;
+    }
+    if (lhs.gatherer_id != rhs.gatherer_id) {
+        return lhs.gatherer_id < rhs.gatherer_id;
+    }
+    return lhs.item_id < rhs.item_id;
+}
+
+}  // namespace
+
+std::vector<GatheringEvent> FindGatherEvents(std::span<const Item> items,
+                                             std::span<const Gatherer> gatherers) {
+    const double max_item_width = GetMaxItemWidth(items);
+    const ItemGrid grid{items, ChooseCellSize(gatherers, max_item_width)};
+
+    std::vector<GatheringEvent> events;
+    CollectEvents(grid, max_item_width, gatherers, 0, gatherers.size(), events);
+    std::sort(events.begin(), events.end(), EventLess);
+    return events;
+}
+
+std::vector<GatheringEvent> FindGatherEventsParallel(std::span<const Item> items,
+                                                     std::span<const Gatherer> gatherers,
+                                                     unsigned thread_count) {
+    // Слишком мелкие части не окупают запуск потоков
+    constexpr size_t MIN_GATHERERS_PER_THREAD = 64;
+    thread_count = static_cast<unsigned>(
+        std::min<size_t>(thread_count, gatherers.size() / MIN_GATHERERS_PER_THREAD));
+    if (thread_count <= 1) {
+        return FindGatherEvents(items, gatherers);
+    }
+
+    const double max_item_width = GetMaxItemWidth(items);
+    const ItemGrid grid{items, ChooseCellSize(gatherers, max_item_width)};
+
+    // Каждый поток обрабатывает свой непрерывный диапазон собирателей и сортирует свои события
+    std::vector<std::vector<GatheringEvent>> thread_events(thread_count);
+    std::vector<std::exception_ptr> errors(thread_count);
+    {
+        std::vector<std::jthread> workers;
+        workers.reserve(thread_count - 1);
+        auto work = [&](unsigned thread_index) {
+            try {
+                const size_t first = gatherers.size() * thread_index / thread_count;
+                const size_t last = gatherers.size() * (thread_index + 1) / thread_count;
+                auto& events = thread_events[thread_index];
+                CollectEvents(grid, max_item_width, gatherers, first, last, events);
+                std::sort(events.begin(), events.end(), EventLess);
+            } catch (...) {
+                errors[thread_index] = std::current_exception();
+            }
+        };
+        for (unsigned i = 1; i < thread_count; ++i) {
+            workers.emplace_back(work, i);
+        }
+        work(0);
+    }
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    // Слияние отсортированных частей
+    size_t total = 0;
+    for (const auto& events : thread_events) {
+        total += events.size();
+    }
+    std::vector<GatheringEvent> events;
+    events.reserve(total);
+    for (const auto& part : thread_events) {
+        const auto middle = events.insert(events.end(), part.begin(), part.end());
+        std::inplace_merge(events.begin(), middle, events.end(), EventLess);
+    }
+    return events;
+}
+
+std::vector<GatheringEvent> FindGatherEvents(const ItemIndex& index,
+                                             std::span<const Gatherer> gatherers) {
+    std::vector<GatheringEvent> events;
+    CollectEvents(index, index.GetMaxItemWidth(), gatherers, 0, gatherers.size(), events);
+    std::sort(events.begin(), events.end(), EventLess);
+    return events;
+}
+
 std::vector<GatheringEvent> FindGatherEvents(const ItemGathererProvider& provider) {
+    // Каждый элемент читается через виртуальный вызов ровно один раз
+    std::vector<Item> items;
+    items.reserve(provider.ItemsCount());
+    for (size_t i = 0; i < provider.ItemsCount(); ++i) {
+        items.push_back(provider.GetItem(i));
+    }
+    std::vector<Gatherer> gatherers;
+    gatherers.reserve(provider.GatherersCount());
+    for (size_t i = 0; i < provider.GatherersCount(); ++i) {
+        gatherers.push_back(provider.GetGatherer(i));
+    }
+    return FindGatherEvents(items, gatherers);
 }
-*/
 
 }  // namespace collision_detector
\ No newline at end of file
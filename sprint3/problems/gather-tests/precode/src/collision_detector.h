@@ -3,6 +3,7 @@
 #include "geom.h"
 
 #include <algorithm>
+#include <span>
 #include <vector>
 
 namespace collision_detector {
@@ -52,8 +53,22 @@ struct GatheringEvent {
     double time;
 };
 
-// Эту функцию вам нужно будет реализовать в соответствующем задании.
-// При проверке ваших тестов она не нужна - функция будет линковаться снаружи.
+// Возвращает события сбора предметов, упорядоченные по времени
+// (при равном времени - по gatherer_id, затем по item_id).
+// item_id и gatherer_id - индексы в items и gatherers.
+// Точная проверка TryCollectPoint выполняется только для предметов из ячеек
+// равномерной сетки, которые задевает перемещение собирателя.
+std::vector<GatheringEvent> FindGatherEvents(std::span<const Item> items,
+                                             std::span<const Gatherer> gatherers);
+
+// То же, что FindGatherEvents, но собиратели делятся между thread_count потоками.
+// Результат в точности совпадает с последовательной версией
+std::vector<GatheringEvent> FindGatherEventsParallel(std::span<const Item> items,
+                                                     std::span<const Gatherer> gatherers,
+                                                     unsigned thread_count);
+
+// Адаптер для поставщиков с виртуальным интерфейсом: копирует предметы и собирателей
+// в непрерывные массивы и вызывает FindGatherEvents для них
 std::vector<GatheringEvent> FindGatherEvents(const ItemGathererProvider& provider);
 
 }  // namespace collision_detector
\ No newline at end of file
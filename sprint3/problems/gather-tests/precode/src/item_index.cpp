@@ -0,0 +1,93 @@
+#include "item_index.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace collision_detector {
+
+namespace {
+
+// reserve(size() + 1) отключил бы геометрический рост ёмкости
+template <typename T>
+void ReserveOneMore(std::vector<T>& values) {
+    if (values.size() == values.capacity()) {
+        values.reserve(std::max<size_t>(values.capacity() * 2, 4));
+    }
+}
+
+}  // namespace
+
+ItemIndex::ItemIndex(double cell_size)
+    : cell_size_{cell_size} {
+    if (!(cell_size > 0)) {
+        throw std::invalid_argument("Cell size must be positive");
+    }
+}
+
+void ItemIndex::Insert(ItemId id, const Item& item) {
+    if (Contains(id)) {
+        throw std::invalid_argument("Item is already in index");
+    }
+    if (!std::isfinite(item.position.x) || !std::isfinite(item.position.y)) {
+        throw std::invalid_argument("Item position must be finite");
+    }
+
+    const detail::CellKey cell_key = detail::GetCell(item.position, cell_size_);
+    Cell& cell = cells_[cell_key];
+    const size_t position = cell.ids.size();
+    // Память выделяется заранее, чтобы массивы ячейки не разошлись по длине при исключении
+    ReserveOneMore(cell.x);
+    ReserveOneMore(cell.y);
+    ReserveOneMore(cell.width);
+    ReserveOneMore(cell.ids);
+    locations_.emplace(id, Location{cell_key, position});
+    try {
+        ++width_counts_[item.width];
+    } catch (...) {
+        locations_.erase(id);
+        throw;
+    }
+
+    cell.x.push_back(item.position.x);
+    cell.y.push_back(item.position.y);
+    cell.width.push_back(item.width);
+    cell.ids.push_back(id);
+}
+
+bool ItemIndex::Remove(ItemId id) {
+    auto location = locations_.find(id);
+    if (location == locations_.end()) {
+        return false;
+    }
+
+    auto cell_it = cells_.find(location->second.cell);
+    Cell& cell = cell_it->second;
+    const size_t position = location->second.position;
+    const size_t last = cell.ids.size() - 1;
+
+    if (auto width = width_counts_.find(cell.width[position]); --width->second == 0) {
+        width_counts_.erase(width);
+    }
+
+    // Последний предмет ячейки занимает место удалённого
+    if (position != last) {
+        cell.x[position] = cell.x[last];
+        cell.y[position] = cell.y[last];
+        cell.width[position] = cell.width[last];
+        cell.ids[position] = cell.ids[last];
+        locations_.at(cell.ids[position]).position = position;
+    }
+    cell.x.pop_back();
+    cell.y.pop_back();
+    cell.width.pop_back();
+    cell.ids.pop_back();
+    if (cell.ids.empty()) {
+        cells_.erase(cell_it);
+    }
+
+    locations_.erase(location);
+    return true;
+}
+
+}  // namespace collision_detector
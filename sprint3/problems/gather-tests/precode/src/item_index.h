@@ -0,0 +1,147 @@
+#pragma once
+
+#include "collision_batch.h"
+#include "collision_detector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace collision_detector {
+
+namespace detail {
+
+// Ячейка равномерной сетки
+struct CellKey {
+    int64_t x;
+    int64_t y;
+
+    auto operator<=>(const CellKey&) const = default;
+};
+
+struct CellKeyHasher {
+    size_t operator()(const CellKey& key) const noexcept {
+        // Перемножаются беззнаковые числа: переполнение знаковых - неопределённое поведение
+        return std::hash<uint64_t>{}(static_cast<uint64_t>(key.x) * 73856093u
+                                     ^ static_cast<uint64_t>(key.y) * 19349663u);
+    }
+};
+
+// Номера ячеек ограничены так, чтобы приведение к int64_t и перебор диапазона ячеек не переполнялись
+inline constexpr double MAX_CELL_COORD = 4611686018427387904.0;  // 2^62
+
+// Номер ячейки по одной координате. Слишком далёкие координаты попадают в крайние ячейки,
+// а NaN - в нулевую
+inline int64_t GetCellCoord(double coord, double cell_size) noexcept {
+    const double cell = std::floor(coord / cell_size);
+    if (std::isnan(cell)) {
+        return 0;
+    }
+    return static_cast<int64_t>(std::clamp(cell, -MAX_CELL_COORD, MAX_CELL_COORD));
+}
+
+inline CellKey GetCell(geom::Point2D point, double cell_size) noexcept {
+    return {GetCellCoord(point.x, cell_size), GetCellCoord(point.y, cell_size)};
+}
+
+/*
+ * Вызывает fn(cell) для непустых ячеек cells, попадающих в диапазон [min_cell, max_cell].
+ * Если диапазон покрывает больше ячеек, чем есть непустых, дешевле перебрать непустые ячейки
+ */
+template <typename Cells, typename Fn>
+void ForEachCellInBox(const Cells& cells, CellKey min_cell, CellKey max_cell, Fn&& fn) {
+    const double cells_in_box = (static_cast<double>(max_cell.x) - min_cell.x + 1)
+                              * (static_cast<double>(max_cell.y) - min_cell.y + 1);
+    if (cells_in_box > static_cast<double>(cells.size())) {
+        for (const auto& [cell, value] : cells) {
+            if (cell.x >= min_cell.x && cell.x <= max_cell.x && cell.y >= min_cell.y
+                && cell.y <= max_cell.y) {
+                fn(value);
+            }
+        }
+        return;
+    }
+    for (int64_t x = min_cell.x; x <= max_cell.x; ++x) {
+        for (int64_t y = min_cell.y; y <= max_cell.y; ++y) {
+            if (auto it = cells.find({x, y}); it != cells.end()) {
+                fn(it->second);
+            }
+        }
+    }
+}
+
+}  // namespace detail
+
+/*
+ * Сетка предметов, которая живёт между тиками.
+ * Предметы появляются и исчезают редко по сравнению с перемещениями собирателей,
+ * поэтому вместо перестроения сетки на каждом тике в неё добавляются
+ * и из неё удаляются только изменившиеся предметы.
+ */
+class ItemIndex {
+public:
+    using ItemId = size_t;
+
+    // cell_size - сторона ячейки, удобно брать равной типичному радиусу сбора
+    explicit ItemIndex(double cell_size);
+
+    // Выбрасывает std::invalid_argument, если предмет с таким id уже есть
+    // или координаты предмета не конечны
+    void Insert(ItemId id, const Item& item);
+    bool Remove(ItemId id);
+
+    bool Contains(ItemId id) const noexcept {
+        return locations_.contains(id);
+    }
+
+    size_t GetSize() const noexcept {
+        return locations_.size();
+    }
+
+    double GetMaxItemWidth() const noexcept {
+        return width_counts_.empty() ? 0.0 : width_counts_.rbegin()->first;
+    }
+
+    /*
+     * Для каждой ячейки, которая может пересекаться с прямоугольником, вызывает
+     * fn(items, ids): предметы ячейки и их идентификаторы
+     */
+    template <typename Fn>
+    void ForEachCandidateCell(double min_x, double min_y, double max_x, double max_y, Fn&& fn) const {
+        detail::ForEachCellInBox(cells_, detail::GetCell({min_x, min_y}, cell_size_),
+                                 detail::GetCell({max_x, max_y}, cell_size_), [&fn](const Cell& cell) {
+                                     fn(ItemsSoA{cell.x, cell.y, cell.width},
+                                        std::span<const ItemId>{cell.ids});
+                                 });
+    }
+
+private:
+    struct Cell {
+        std::vector<double> x;
+        std::vector<double> y;
+        std::vector<double> width;
+        std::vector<ItemId> ids;
+    };
+
+    struct Location {
+        detail::CellKey cell;
+        size_t position;
+    };
+
+    double cell_size_;
+    std::unordered_map<detail::CellKey, Cell, detail::CellKeyHasher> cells_;
+    std::unordered_map<ItemId, Location> locations_;
+    // Сколько предметов каждой ширины: позволяет поддерживать наибольшую ширину при удалении
+    std::map<double, size_t> width_counts_;
+};
+
+// События сбора предметов из index, упорядоченные так же, как в FindGatherEvents.
+// item_id событий - идентификаторы, под которыми предметы добавлены в index
+std::vector<GatheringEvent> FindGatherEvents(const ItemIndex& index,
+                                             std::span<const Gatherer> gatherers);
+
+}  // namespace collision_detector
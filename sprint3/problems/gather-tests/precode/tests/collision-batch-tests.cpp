@@ -0,0 +1,82 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <random>
+
+#include "../src/collision_batch.h"
+#include "../src/collision_detector.h"
+
+using namespace collision_detector;
+
+namespace {
+
+struct Items {
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> width;
+
+    ItemsSoA View() const {
+        return {x, y, width};
+    }
+};
+
+Items GenerateItems(size_t count, std::mt19937& generator) {
+    std::uniform_real_distribution<double> coord{-5.0, 15.0};
+    std::uniform_real_distribution<double> width{0.0, 1.0};
+    Items items;
+    for (size_t i = 0; i < count; ++i) {
+        items.x.push_back(coord(generator));
+        items.y.push_back(coord(generator));
+        items.width.push_back(width(generator));
+    }
+    return items;
+}
+
+void CheckSameHits(const std::vector<BatchHit>& lhs, const std::vector<BatchHit>& rhs) {
+    REQUIRE(lhs.size() == rhs.size());
+    for (size_t i = 0; i < lhs.size(); ++i) {
+        CHECK(lhs[i].index == rhs[i].index);
+        CHECK(lhs[i].sq_distance == rhs[i].sq_distance);
+        CHECK(lhs[i].proj_ratio == rhs[i].proj_ratio);
+    }
+}
+
+}  // namespace
+
+SCENARIO("Batch point collection") {
+    GIVEN("random items and a gatherer") {
+        std::mt19937 generator{42};
+        const geom::Point2D a{0.0, 0.0};
+        const geom::Point2D b{10.0, 7.0};
+        constexpr double gatherer_width = 0.6;
+
+        // Размеры, не кратные ширине вектора, проверяют обработку хвоста
+        for (size_t count : {0, 1, 3, 4, 7, 64, 1001}) {
+            const Items items = GenerateItems(count, generator);
+
+            THEN("batch results match TryCollectPoint for " << count << " items") {
+                std::vector<BatchHit> hits;
+                CollectPointsBatch(a, b, gatherer_width, items.View(), hits);
+
+                std::vector<BatchHit> expected;
+                for (size_t i = 0; i < count; ++i) {
+                    const auto result = TryCollectPoint(a, b, {items.x[i], items.y[i]});
+                    if (result.IsCollected(gatherer_width + items.width[i])) {
+                        expected.push_back({i, result.sq_distance, result.proj_ratio});
+                    }
+                }
+                CheckSameHits(hits, expected);
+            }
+
+            THEN("vector and scalar kernels agree for " << count << " items") {
+                // На процессоре без AVX2 векторное ядро завершилось бы по SIGILL
+                if (detail::HasAvx2()) {
+                    std::vector<BatchHit> scalar_hits;
+                    std::vector<BatchHit> vector_hits;
+                    detail::CollectPointsScalar(a, b, gatherer_width, items.View(), scalar_hits);
+                    detail::CollectPointsAvx2(a, b, gatherer_width, items.View(), vector_hits);
+                    CheckSameHits(vector_hits, scalar_hits);
+                }
+            }
+        }
+    }
+}
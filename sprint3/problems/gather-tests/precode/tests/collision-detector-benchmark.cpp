@@ -0,0 +1,109 @@
+// Замеры производительности поиска событий сбора.
+// Запуск: collision_detection_benchmark [число повторов]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+
+#include "../src/collision_detector.h"
+#include "../src/item_index.h"
+
+using namespace collision_detector;
+using namespace std::literals;
+
+namespace {
+
+struct Scene {
+    std::vector<Item> items;
+    std::vector<Gatherer> gatherers;
+};
+
+// Плотность предметов и длина шага собирателя примерно как в игре:
+// собиратель за тик проходит несколько единиц карты
+Scene GenerateScene(size_t items_count, size_t gatherers_count, std::mt19937_64& generator) {
+    const double field_size = std::sqrt(static_cast<double>(std::max(items_count, gatherers_count))) * 4.0;
+    std::uniform_real_distribution<double> coord{0.0, field_size};
+    std::uniform_real_distribution<double> step{-3.0, 3.0};
+
+    Scene scene;
+    scene.items.reserve(items_count);
+    for (size_t i = 0; i < items_count; ++i) {
+        scene.items.push_back({{coord(generator), coord(generator)}, 0.0});
+    }
+    scene.gatherers.reserve(gatherers_count);
+    for (size_t i = 0; i < gatherers_count; ++i) {
+        const geom::Point2D start{coord(generator), coord(generator)};
+        scene.gatherers.push_back({start, {start.x + step(generator), start.y + step(generator)}, 0.6});
+    }
+    return scene;
+}
+
+// Лучшее из repeats измерений, в микросекундах
+template <typename Fn>
+double Measure(int repeats, Fn&& fn) {
+    auto best = std::chrono::steady_clock::duration::max();
+    size_t checksum = 0;
+    for (int i = 0; i < repeats; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        checksum += fn().size();
+        best = std::min(best, std::chrono::steady_clock::now() - start);
+    }
+    // Не даём компилятору выбросить вычисления
+    if (checksum == static_cast<size_t>(-1)) {
+        std::cerr << checksum;
+    }
+    return std::chrono::duration<double, std::micro>(best).count();
+}
+
+}  // namespace
+
+int main(int argc, const char* argv[]) {
+    const int repeats = argc > 1 ? std::max(1, std::atoi(argv[1])) : 5;
+    const unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    std::mt19937_64 generator{1};
+
+    std::cout << std::setw(9) << "items" << std::setw(11) << "gatherers" << std::setw(13) << "events"
+              << std::setw(13) << "serial,us" << std::setw(15) << "parallel,us" << std::setw(12)
+              << "index,us" << std::setw(12) << "index+ins" << std::endl;
+
+    for (size_t items_count : {100, 1'000, 10'000, 100'000}) {
+        for (size_t gatherers_count : {10, 100, 1'000, 10'000}) {
+            const Scene scene = GenerateScene(items_count, gatherers_count, generator);
+
+            ItemIndex index{1.2};
+            for (size_t i = 0; i < scene.items.size(); ++i) {
+                index.Insert(i, scene.items[i]);
+            }
+
+            const size_t events = FindGatherEvents(scene.items, scene.gatherers).size();
+            const double serial = Measure(repeats, [&] {
+                return FindGatherEvents(scene.items, scene.gatherers);
+            });
+            const double parallel = Measure(repeats, [&] {
+                return FindGatherEventsParallel(scene.items, scene.gatherers, threads);
+            });
+            const double indexed = Measure(repeats, [&] {
+                return FindGatherEvents(index, scene.gatherers);
+            });
+            // Типичный тик: несколько предметов подобрано и столько же появилось
+            const double indexed_with_updates = Measure(repeats, [&] {
+                const size_t changed = std::min<size_t>(10, scene.items.size());
+                for (size_t i = 0; i < changed; ++i) {
+                    index.Remove(i);
+                    index.Insert(i, scene.items[i]);
+                }
+                return FindGatherEvents(index, scene.gatherers);
+            });
+
+            std::cout << std::fixed << std::setprecision(1) << std::setw(9) << items_count
+                      << std::setw(11) << gatherers_count << std::setw(13) << events << std::setw(13)
+                      << serial << std::setw(15) << parallel << std::setw(12) << indexed
+                      << std::setw(12) << indexed_with_updates << std::endl;
+        }
+    }
+}
@@ -0,0 +1,176 @@
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <random>
+#include <tuple>
+
+#include "../src/collision_batch.h"
+#include "../src/collision_detector.h"
+#include "../src/item_index.h"
+
+using namespace collision_detector;
+
+namespace {
+
+class VectorProvider : public ItemGathererProvider {
+public:
+    VectorProvider(const std::vector<Item>& items, const std::vector<Gatherer>& gatherers)
+        : items_{items}
+        , gatherers_{gatherers} {
+    }
+
+    size_t ItemsCount() const override {
+        return items_.size();
+    }
+
+    Item GetItem(size_t idx) const override {
+        return items_.at(idx);
+    }
+
+    size_t GatherersCount() const override {
+        return gatherers_.size();
+    }
+
+    Gatherer GetGatherer(size_t idx) const override {
+        return gatherers_.at(idx);
+    }
+
+private:
+    const std::vector<Item>& items_;
+    const std::vector<Gatherer>& gatherers_;
+};
+
+using EventTuple = std::tuple<size_t, size_t, double, double>;
+
+std::vector<EventTuple> ToTuples(const std::vector<GatheringEvent>& events) {
+    std::vector<EventTuple> tuples;
+    for (const auto& event : events) {
+        tuples.emplace_back(event.item_id, event.gatherer_id, event.sq_distance, event.time);
+    }
+    return tuples;
+}
+
+// Эталон: каждый собиратель проверяется с каждым предметом
+std::vector<GatheringEvent> FindGatherEventsBruteForce(const std::vector<Item>& items,
+                                                       const std::vector<Gatherer>& gatherers) {
+    std::vector<GatheringEvent> events;
+    for (size_t gatherer_id = 0; gatherer_id < gatherers.size(); ++gatherer_id) {
+        const Gatherer& gatherer = gatherers[gatherer_id];
+        if (gatherer.start_pos.x == gatherer.end_pos.x && gatherer.start_pos.y == gatherer.end_pos.y) {
+            continue;
+        }
+        for (size_t item_id = 0; item_id < items.size(); ++item_id) {
+            const Item& item = items[item_id];
+            const auto result = TryCollectPoint(gatherer.start_pos, gatherer.end_pos, item.position);
+            if (result.IsCollected(gatherer.width + item.width)) {
+                events.push_back({item_id, gatherer_id, result.sq_distance, result.proj_ratio});
+            }
+        }
+    }
+    std::sort(events.begin(), events.end(), [](const auto& lhs, const auto& rhs) {
+        return std::tie(lhs.time, lhs.gatherer_id, lhs.item_id)
+             < std::tie(rhs.time, rhs.gatherer_id, rhs.item_id);
+    });
+    return events;
+}
+
+/*
+ * Координаты и ширины берутся с крупным двоичным шагом, поэтому вычисления точны
+ * и часто попадают ровно на границу: предмет на расстоянии радиуса, в начале
+ * или в конце отрезка, несколько предметов в одной точке
+ */
+struct Scene {
+    std::vector<Item> items;
+    std::vector<Gatherer> gatherers;
+};
+
+Scene GenerateScene(std::mt19937_64& generator, double field_size) {
+    std::uniform_int_distribution<int> items_count{0, 300};
+    std::uniform_int_distribution<int> gatherers_count{0, 40};
+    std::uniform_int_distribution<int> cell{0, static_cast<int>(field_size * 4)};
+    std::uniform_int_distribution<int> width_steps{0, 6};
+    std::bernoulli_distribution is_standing{0.15};
+    std::bernoulli_distribution is_axis_aligned{0.5};
+
+    auto random_point = [&] {
+        return geom::Point2D{cell(generator) * 0.25, cell(generator) * 0.25};
+    };
+
+    Scene scene;
+    for (int i = items_count(generator); i > 0; --i) {
+        scene.items.push_back({random_point(), width_steps(generator) * 0.125});
+    }
+    for (int i = gatherers_count(generator); i > 0; --i) {
+        const geom::Point2D start = random_point();
+        geom::Point2D end = random_point();
+        if (is_standing(generator)) {
+            end = start;
+        } else if (is_axis_aligned(generator)) {
+            end.y = start.y;
+        }
+        scene.gatherers.push_back({start, end, width_steps(generator) * 0.125});
+    }
+    return scene;
+}
+
+}  // namespace
+
+SCENARIO("Optimized gathering agrees with brute force") {
+    GIVEN("an item exactly at the gathering radius") {
+        const std::vector<Item> items{{{2.0, 0.75}, 0.25}, {{3.0, 0.75}, 0.125}, {{0.0, -0.5}, 0.0}};
+        const std::vector<Gatherer> gatherers{{{0.0, 0.0}, {4.0, 0.0}, 0.5}};
+
+        THEN("it is gathered, a slightly farther one is not") {
+            const auto events = FindGatherEvents(items, gatherers);
+            REQUIRE(events.size() == 2);
+            CHECK(events[0].item_id == 2);
+            CHECK(events[0].time == 0.0);
+            CHECK(events[1].item_id == 0);
+            CHECK(events[1].sq_distance == 0.5625);
+            CHECK(ToTuples(events) == ToTuples(FindGatherEventsBruteForce(items, gatherers)));
+        }
+    }
+
+    GIVEN("randomly generated scenes") {
+        std::mt19937_64 generator{20240601};
+
+        THEN("every implementation finds the same events as brute force") {
+            for (int iteration = 0; iteration < 200; ++iteration) {
+                // Мелкие поля дают плотные сцены, крупные - почти пустые ячейки
+                const double field_size = iteration % 2 == 0 ? 4.0 : 64.0;
+                const Scene scene = GenerateScene(generator, field_size);
+                INFO("iteration: " << iteration << ", items: " << scene.items.size()
+                                   << ", gatherers: " << scene.gatherers.size());
+
+                const auto expected = ToTuples(FindGatherEventsBruteForce(scene.items, scene.gatherers));
+                CHECK(ToTuples(FindGatherEvents(scene.items, scene.gatherers)) == expected);
+                CHECK(ToTuples(FindGatherEvents(VectorProvider{scene.items, scene.gatherers}))
+                      == expected);
+                CHECK(ToTuples(FindGatherEventsParallel(scene.items, scene.gatherers, 4)) == expected);
+
+                ItemIndex index{0.5};
+                for (size_t i = 0; i < scene.items.size(); ++i) {
+                    index.Insert(i, scene.items[i]);
+                }
+                CHECK(ToTuples(FindGatherEvents(index, scene.gatherers)) == expected);
+            }
+        }
+    }
+
+    GIVEN("many gatherers, so that the work is split between threads") {
+        std::mt19937_64 generator{7};
+        Scene scene = GenerateScene(generator, 32.0);
+        while (scene.gatherers.size() < 1000) {
+            const Scene more = GenerateScene(generator, 32.0);
+            scene.gatherers.insert(scene.gatherers.end(), more.gatherers.begin(), more.gatherers.end());
+        }
+
+        THEN("the parallel search agrees with brute force") {
+            const auto expected = ToTuples(FindGatherEventsBruteForce(scene.items, scene.gatherers));
+            for (unsigned threads : {2u, 5u, 16u}) {
+                INFO("threads: " << threads);
+                CHECK(ToTuples(FindGatherEventsParallel(scene.items, scene.gatherers, threads))
+                      == expected);
+            }
+        }
+    }
+}
@@ -1,5 +1,151 @@
 #define _USE_MATH_DEFINES
 
+#include <catch2/catch_test_macros.hpp>
+#include <tuple>
+
 #include "../src/collision_detector.h"
 
-// Напишите здесь тесты для функции collision_detector::FindGatherEvents
\ No newline at end of file
+using namespace collision_detector;
+
+namespace {
+
+class TestProvider : public ItemGathererProvider {
+public:
+    TestProvider(std::vector<Item> items, std::vector<Gatherer> gatherers)
+        : items_{std::move(items)}
+        , gatherers_{std::move(gatherers)} {
+    }
+
+    size_t ItemsCount() const override {
+        return items_.size();
+    }
+
+    Item GetItem(size_t idx) const override {
+        return items_.at(idx);
+    }
+
+    size_t GatherersCount() const override {
+        return gatherers_.size();
+    }
+
+    Gatherer GetGatherer(size_t idx) const override {
+        return gatherers_.at(idx);
+    }
+
+private:
+    std::vector<Item> items_;
+    std::vector<Gatherer> gatherers_;
+};
+
+using EventTuple = std::tuple<size_t, size_t, double, double>;
+
+std::vector<EventTuple> ToTuples(const std::vector<GatheringEvent>& events) {
+    std::vector<EventTuple> tuples;
+    for (const auto& event : events) {
+        tuples.emplace_back(event.item_id, event.gatherer_id, event.sq_distance, event.time);
+    }
+    return tuples;
+}
+
+}  // namespace
+
+SCENARIO("Gathering events") {
+    GIVEN("a gatherer moving along the x axis") {
+        const Gatherer gatherer{{0.0, 0.0}, {10.0, 0.0}, 0.6};
+
+        WHEN("items lie near and far from its path") {
+            TestProvider provider{{{{5.0, 0.5}, 0.0},
+                                   {{2.0, 0.0}, 0.1},
+                                   {{5.0, 2.0}, 0.1},
+                                   {{-1.0, 0.0}, 0.1},
+                                   {{10.0, -0.6}, 0.0}},
+                                  {gatherer}};
+            const auto events = FindGatherEvents(provider);
+
+            THEN("only reachable items are gathered in order of time") {
+                REQUIRE(events.size() == 3);
+                CHECK(events[0].item_id == 1);
+                CHECK(events[0].time == 0.2);
+                CHECK(events[1].item_id == 0);
+                CHECK(events[1].sq_distance == 0.25);
+                CHECK(events[2].item_id == 4);
+                CHECK(events[2].time == 1.0);
+                for (const auto& event : events) {
+                    CHECK(event.gatherer_id == 0);
+                }
+            }
+        }
+    }
+
+    GIVEN("gatherers far apart from each other") {
+        TestProvider provider{{{{1000.0, 1000.0}, 0.5}, {{-500.0, 3.0}, 0.5}},
+                              {{{999.0, 1000.0}, {1001.0, 1000.0}, 0.1},
+                               {{-500.0, 0.0}, {-500.0, 5.0}, 0.1},
+                               {{0.0, 0.0}, {0.0, 0.0}, 100.0}}};
+
+        WHEN("events are found") {
+            const auto events = FindGatherEvents(provider);
+
+            THEN("each gatherer collects the item on its path, a standing gatherer collects nothing") {
+                REQUIRE(events.size() == 2);
+                CHECK(events[0].gatherer_id == 0);
+                CHECK(events[0].item_id == 0);
+                CHECK(events[0].time == 0.5);
+                CHECK(events[1].gatherer_id == 1);
+                CHECK(events[1].item_id == 1);
+            }
+        }
+    }
+
+    GIVEN("two gatherers reaching the same item at the same time") {
+        TestProvider provider{{{{1.0, 0.0}, 0.0}},
+                              {{{0.0, 0.0}, {2.0, 0.0}, 0.5}, {{0.0, 0.0}, {2.0, 0.0}, 0.5}}};
+
+        THEN("events are ordered by gatherer id") {
+            const auto events = FindGatherEvents(provider);
+            REQUIRE(events.size() == 2);
+            CHECK(events[0].gatherer_id == 0);
+            CHECK(events[1].gatherer_id == 1);
+        }
+    }
+}
+
+SCENARIO("Gathering events from contiguous arrays") {
+    GIVEN("items and gatherers stored in vectors") {
+        const std::vector<Item> items{{{1.0, 0.0}, 0.0}, {{3.0, 0.2}, 0.0}, {{3.0, 5.0}, 0.0}};
+        const std::vector<Gatherer> gatherers{{{0.0, 0.0}, {4.0, 0.0}, 0.5}};
+
+        THEN("span-based search gives the same events as the virtual provider") {
+            const auto events = FindGatherEvents(items, gatherers);
+            REQUIRE(events.size() == 2);
+            CHECK(ToTuples(FindGatherEvents(TestProvider{items, gatherers})) == ToTuples(events));
+            CHECK(events[0].item_id == 0);
+            CHECK(events[1].item_id == 1);
+        }
+    }
+}
+
+SCENARIO("Parallel gathering events") {
+    GIVEN("many gatherers crossing a field of items") {
+        std::vector<Item> items;
+        for (int x = 0; x < 50; ++x) {
+            for (int y = 0; y < 50; ++y) {
+                items.push_back({{x * 0.5, y * 0.5}, 0.05});
+            }
+        }
+        std::vector<Gatherer> gatherers;
+        for (int i = 0; i < 400; ++i) {
+            const double y = (i % 50) * 0.5 + (i % 3) * 0.1;
+            gatherers.push_back({{i % 7 * 0.1, y}, {20.0 - i % 5, y + 0.25}, 0.3});
+        }
+
+        THEN("the result does not depend on the number of threads") {
+            const auto serial = FindGatherEvents(items, gatherers);
+            REQUIRE_FALSE(serial.empty());
+            for (unsigned threads : {2u, 3u, 4u, 8u}) {
+                INFO("threads: " << threads);
+                CHECK(ToTuples(FindGatherEventsParallel(items, gatherers, threads)) == ToTuples(serial));
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,180 @@
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+
+#include "../src/item_index.h"
+
+using namespace collision_detector;
+
+namespace {
+
+using EventTuple = std::tuple<size_t, size_t, double, double>;
+
+std::vector<EventTuple> ToTuples(const std::vector<GatheringEvent>& events) {
+    std::vector<EventTuple> tuples;
+    for (const auto& event : events) {
+        tuples.emplace_back(event.item_id, event.gatherer_id, event.sq_distance, event.time);
+    }
+    return tuples;
+}
+
+}  // namespace
+
+SCENARIO("Item index") {
+    GIVEN("an empty index") {
+        ItemIndex index{1.0};
+        const std::vector<Gatherer> gatherers{{{0.0, 0.0}, {10.0, 0.0}, 0.5}};
+
+        THEN("nothing is gathered") {
+            CHECK(index.GetSize() == 0);
+            CHECK(index.GetMaxItemWidth() == 0.0);
+            CHECK(FindGatherEvents(index, gatherers).empty());
+        }
+
+        WHEN("items are inserted") {
+            index.Insert(10, {{2.0, 0.0}, 0.1});
+            index.Insert(20, {{5.0, 3.0}, 0.1});
+            index.Insert(30, {{7.0, 0.2}, 0.3});
+
+            THEN("events refer to item ids of the index") {
+                CHECK(index.GetSize() == 3);
+                CHECK(index.GetMaxItemWidth() == 0.3);
+                const auto events = FindGatherEvents(index, gatherers);
+                REQUIRE(events.size() == 2);
+                CHECK(events[0].item_id == 10);
+                CHECK(events[1].item_id == 30);
+            }
+
+            THEN("an id cannot be inserted twice") {
+                CHECK_THROWS_AS(index.Insert(10, {{0.0, 0.0}, 0.1}), std::invalid_argument);
+                CHECK(index.GetSize() == 3);
+            }
+
+            THEN("items with non-finite positions are rejected") {
+                const double nan = std::numeric_limits<double>::quiet_NaN();
+                const double inf = std::numeric_limits<double>::infinity();
+                CHECK_THROWS_AS(index.Insert(40, {{nan, 0.0}, 0.1}), std::invalid_argument);
+                CHECK_THROWS_AS(index.Insert(40, {{0.0, -inf}, 0.1}), std::invalid_argument);
+                CHECK(index.GetSize() == 3);
+            }
+
+            AND_WHEN("far away items are inserted") {
+                index.Insert(40, {{1e300, -1e300}, 0.1});
+                index.Insert(50, {{-1e300, 1e300}, 0.1});
+
+                THEN("nearby items are still gathered") {
+                    const auto events = FindGatherEvents(index, gatherers);
+                    REQUIRE(events.size() == 2);
+                    CHECK(events[0].item_id == 10);
+                    CHECK(events[1].item_id == 30);
+                }
+            }
+
+            AND_WHEN("an item is removed") {
+                CHECK(index.Remove(10));
+                CHECK_FALSE(index.Remove(10));
+
+                THEN("it is no longer gathered and the max width is kept") {
+                    CHECK_FALSE(index.Contains(10));
+                    const auto events = FindGatherEvents(index, gatherers);
+                    REQUIRE(events.size() == 1);
+                    CHECK(events[0].item_id == 30);
+                    CHECK(index.GetMaxItemWidth() == 0.3);
+                }
+            }
+
+            AND_WHEN("the widest item is removed") {
+                CHECK(index.Remove(30));
+
+                THEN("the max width shrinks") {
+                    CHECK(index.GetMaxItemWidth() == 0.1);
+                }
+            }
+        }
+    }
+
+    GIVEN("items changing between ticks") {
+        std::mt19937_64 generator{42};
+        std::uniform_real_distribution<double> coord{0.0, 50.0};
+        std::uniform_real_distribution<double> width{0.0, 0.5};
+
+        ItemIndex index{1.0};
+        std::vector<std::pair<size_t, Item>> alive;
+        size_t next_id = 0;
+        auto add_item = [&] {
+            const Item item{{coord(generator), coord(generator)}, width(generator)};
+            index.Insert(next_id, item);
+            alive.emplace_back(next_id++, item);
+        };
+        for (int i = 0; i < 200; ++i) {
+            add_item();
+        }
+
+        THEN("the index gives the same events as a grid built from scratch") {
+            for (int tick = 0; tick < 20; ++tick) {
+                // Часть предметов подобрана, часть появилась
+                for (int i = 0; i < 10; ++i) {
+                    const size_t victim = generator() % alive.size();
+                    REQUIRE(index.Remove(alive[victim].first));
+                    alive[victim] = alive.back();
+                    alive.pop_back();
+                }
+                for (int i = 0; i < 10; ++i) {
+                    add_item();
+                }
+
+                std::vector<Gatherer> gatherers;
+                for (int i = 0; i < 30; ++i) {
+                    gatherers.push_back({{coord(generator), coord(generator)},
+                                         {coord(generator), coord(generator)},
+                                         width(generator)});
+                }
+
+                std::vector<Item> items;
+                for (const auto& [id, item] : alive) {
+                    items.push_back(item);
+                }
+                auto expected = FindGatherEvents(items, gatherers);
+                for (auto& event : expected) {
+                    event.item_id = alive[event.item_id].first;
+                }
+                // Порядок событий с равным временем зависит от идентификаторов предметов
+                std::sort(expected.begin(), expected.end(), [](const auto& lhs, const auto& rhs) {
+                    return std::tie(lhs.time, lhs.gatherer_id, lhs.item_id)
+                         < std::tie(rhs.time, rhs.gatherer_id, rhs.item_id);
+                });
+
+                REQUIRE(index.GetSize() == alive.size());
+                CHECK(ToTuples(FindGatherEvents(index, gatherers)) == ToTuples(expected));
+            }
+        }
+    }
+}
+
+SCENARIO("Grid cells of extreme coordinates") {
+    using detail::GetCell;
+    using detail::MAX_CELL_COORD;
+
+    THEN("far coordinates fall into the edge cells") {
+        const auto cell = GetCell({1e300, -1e300}, 1.0);
+        CHECK(cell.x == static_cast<int64_t>(MAX_CELL_COORD));
+        CHECK(cell.y == -static_cast<int64_t>(MAX_CELL_COORD));
+        CHECK(GetCell({std::numeric_limits<double>::infinity(), 0.0}, 1e-300).x
+              == static_cast<int64_t>(MAX_CELL_COORD));
+    }
+
+    THEN("NaN falls into the zero cell") {
+        const auto cell = GetCell({std::numeric_limits<double>::quiet_NaN(), 2.5}, 1.0);
+        CHECK(cell.x == 0);
+        CHECK(cell.y == 2);
+    }
+
+    THEN("hashing edge cells is defined") {
+        const detail::CellKeyHasher hasher;
+        CHECK(hasher({std::numeric_limits<int64_t>::max(), std::numeric_limits<int64_t>::min()})
+              != hasher({0, 0}));
+    }
+}
@@ -0,0 +1,56 @@
+#include "batch_loot_generator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace loot_gen {
+
+BatchLootGenerator::BatchLootGenerator(TimeInterval base_interval, double probability,
+                                       uint64_t seed)
+    : base_interval_seconds_{std::chrono::duration<double>{base_interval}.count()}
+    , log_no_loot_{std::log1p(-probability)}
+    , random_{seed} {
+    if (base_interval <= TimeInterval::zero()) {
+        throw std::invalid_argument("Base interval must be positive");
+    }
+    if (!(probability >= 0.0 && probability <= 1.0)) {
+        throw std::invalid_argument("Probability must be in range [0, 1]");
+    }
+}
+
+size_t BatchLootGenerator::AddMap() {
+    time_without_loot_.emplace_back();
+    return time_without_loot_.size() - 1;
+}
+
+void BatchLootGenerator::Generate(TimeInterval time_delta, std::span<const MapState> maps,
+                                  std::span<unsigned> generated) {
+    const size_t map_count = GetMapCount();
+    if (maps.size() != map_count || generated.size() != map_count) {
+        throw std::invalid_argument("Map count mismatch");
+    }
+
+    for (size_t i = 0; i < map_count; ++i) {
+        TimeInterval& time_without_loot = time_without_loot_[i];
+        time_without_loot += time_delta;
+
+        const MapState& map = maps[i];
+        const unsigned loot_shortage
+            = map.loot_count > map.looter_count ? 0u : map.looter_count - map.loot_count;
+        const double ratio
+            = std::chrono::duration<double>{time_without_loot}.count() / base_interval_seconds_;
+        // При probability == 1 логарифм равен -inf, а 0 * -inf не определено
+        const double spawn_probability = ratio > 0.0 ? -std::expm1(ratio * log_no_loot_) : 0.0;
+        // Случайное число выбирается для каждой карты, чтобы последовательность
+        // не зависела от количества мародёров
+        const double probability
+            = std::clamp(spawn_probability * random_.NextDouble(), 0.0, 1.0);
+        generated[i] = static_cast<unsigned>(std::round(loot_shortage * probability));
+        if (generated[i] > 0) {
+            time_without_loot = {};
+        }
+    }
+}
+
+}  // namespace loot_gen
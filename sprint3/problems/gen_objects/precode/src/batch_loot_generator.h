@@ -0,0 +1,69 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "xoshiro.h"
+
+namespace loot_gen {
+
+/*
+ * Генератор трофеев сразу для всех карт.
+ * Для каждой карты считает то же, что и LootGenerator, но:
+ *  - случайные числа берутся из общего генератора xoshiro256++ без косвенного вызова
+ *    через std::function, поэтому при одинаковом зерне результат воспроизводим;
+ *  - log(1 - probability) вычисляется один раз, и вместо pow на каждом вызове
+ *    остаётся одна экспонента.
+ */
+class BatchLootGenerator {
+public:
+    using TimeInterval = std::chrono::milliseconds;
+
+    struct MapState {
+        // количество трофеев на карте
+        unsigned loot_count;
+        // количество мародёров на карте
+        unsigned looter_count;
+    };
+
+    /*
+     * base_interval - базовый отрезок времени > 0
+     * probability - вероятность появления трофея в течение базового интервала времени
+     * seed - зерно генератора псевдослучайных чисел
+     */
+    BatchLootGenerator(TimeInterval base_interval, double probability, uint64_t seed);
+
+    // Добавляет карту и возвращает её индекс в массивах, передаваемых в Generate
+    size_t AddMap();
+
+    size_t GetMapCount() const noexcept {
+        return time_without_loot_.size();
+    }
+
+    /*
+     * Записывает в generated[i] количество трофеев, которые должны появиться на i-й карте
+     * спустя time_delta. Размеры maps и generated должны совпадать с количеством карт,
+     * иначе выбрасывается std::invalid_argument
+     */
+    void Generate(TimeInterval time_delta, std::span<const MapState> maps,
+                  std::span<unsigned> generated);
+
+    /*
+     * Заполняет values числами из [0, 1) из той же последовательности, что и Generate.
+     * Используется для выбора мест и типов появившихся трофеев одним пакетом
+     */
+    void FillUniform(std::span<double> values) noexcept {
+        random_.FillUniform(values);
+    }
+
+private:
+    double base_interval_seconds_;
+    // log(1 - probability): вероятность того, что за время t трофей не появится, равна
+    // exp(t / base_interval * log_no_loot_)
+    double log_no_loot_;
+    std::vector<TimeInterval> time_without_loot_;
+    Xoshiro256PlusPlus random_;
+};
+
+}  // namespace loot_gen
@@ -0,0 +1,73 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+#include <span>
+
+namespace loot_gen {
+
+/*
+ * Генератор псевдослучайных чисел xoshiro256++.
+ * Быстрее std::mt19937_64, состояние занимает 32 байта,
+ * одно и то же зерно всегда даёт одну и ту же последовательность.
+ * Удовлетворяет требованиям UniformRandomBitGenerator
+ */
+class Xoshiro256PlusPlus {
+public:
+    using result_type = uint64_t;
+
+    explicit Xoshiro256PlusPlus(uint64_t seed) noexcept {
+        Seed(seed);
+    }
+
+    // Состояние заполняется генератором splitmix64, поэтому годится любое зерно, включая 0
+    void Seed(uint64_t seed) noexcept {
+        for (uint64_t& word : state_) {
+            seed += 0x9e3779b97f4a7c15;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    static constexpr result_type min() noexcept {
+        return 0;
+    }
+
+    static constexpr result_type max() noexcept {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    result_type operator()() noexcept {
+        const uint64_t result = RotateLeft(state_[0] + state_[3], 23) + state_[0];
+        const uint64_t t = state_[1] << 17;
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = RotateLeft(state_[3], 45);
+        return result;
+    }
+
+    // Равномерно распределённое число в диапазоне [0, 1)
+    double NextDouble() noexcept {
+        // Старшие 53 бита - ровно столько помещается в мантиссу double
+        return static_cast<double>((*this)() >> 11) * 0x1.0p-53;
+    }
+
+    void FillUniform(std::span<double> values) noexcept {
+        for (double& value : values) {
+            value = NextDouble();
+        }
+    }
+
+private:
+    static uint64_t RotateLeft(uint64_t x, int k) noexcept {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    uint64_t state_[4];
+};
+
+}  // namespace loot_gen
@@ -0,0 +1,135 @@
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "../src/batch_loot_generator.h"
+#include "../src/loot_generator.h"
+
+using namespace std::literals;
+
+SCENARIO("Batched loot generation") {
+    using loot_gen::BatchLootGenerator;
+    using MapState = BatchLootGenerator::MapState;
+
+    GIVEN("a batch generator with probability 1 for three maps") {
+        BatchLootGenerator gen{1s, 1.0, 0};
+        for (int i = 0; i < 3; ++i) {
+            gen.AddMap();
+        }
+        REQUIRE(gen.GetMapCount() == 3);
+
+        WHEN("no time has passed") {
+            const std::vector<MapState> maps{{0, 5}, {0, 5}, {0, 5}};
+            std::vector<unsigned> generated(3);
+            gen.Generate(0ms, maps, generated);
+
+            THEN("no loot is generated") {
+                CHECK(generated == std::vector<unsigned>{0, 0, 0});
+            }
+        }
+
+        WHEN("maps have different loot shortage") {
+            const std::vector<MapState> maps{{3, 3}, {7, 2}, {1, 2}};
+            std::vector<unsigned> generated(3);
+
+            THEN("loot never exceeds the number of looters") {
+                for (int i = 0; i < 100; ++i) {
+                    gen.Generate(1s, maps, generated);
+                    CHECK(generated[0] == 0);
+                    CHECK(generated[1] == 0);
+                    CHECK(generated[2] <= 1);
+                }
+            }
+        }
+
+        WHEN("array sizes do not match the number of maps") {
+            const std::vector<MapState> maps{{0, 1}, {0, 1}};
+            std::vector<unsigned> generated(2);
+
+            THEN("an exception is thrown") {
+                CHECK_THROWS_AS(gen.Generate(1s, maps, generated), std::invalid_argument);
+            }
+        }
+    }
+
+    GIVEN("per-map loot generators fed by the same random sequence") {
+        constexpr uint64_t SEED = 12345;
+        constexpr size_t MAP_COUNT = 4;
+        loot_gen::Xoshiro256PlusPlus random{SEED};
+        std::vector<loot_gen::LootGenerator> single_generators;
+        BatchLootGenerator batch{5s, 0.5, SEED};
+        for (size_t i = 0; i < MAP_COUNT; ++i) {
+            single_generators.emplace_back(5s, 0.5, [&random] {
+                return random.NextDouble();
+            });
+            batch.AddMap();
+        }
+
+        THEN("the batch generator gives the same loot") {
+            std::vector<MapState> maps{{0, 10}, {2, 4}, {5, 1}, {0, 30}};
+            std::vector<unsigned> generated(MAP_COUNT);
+            for (int tick = 0; tick < 200; ++tick) {
+                const auto time_delta = std::chrono::milliseconds{50 + tick * 37 % 2000};
+                batch.Generate(time_delta, maps, generated);
+                for (size_t i = 0; i < MAP_COUNT; ++i) {
+                    INFO("tick: " << tick << ", map: " << i);
+                    CHECK(generated[i]
+                          == single_generators[i].Generate(time_delta, maps[i].loot_count,
+                                                           maps[i].looter_count));
+                    maps[i].loot_count = (maps[i].loot_count + generated[i]) % 12;
+                }
+            }
+        }
+    }
+
+    GIVEN("two batch generators") {
+        auto run = [](uint64_t seed) {
+            BatchLootGenerator gen{1s, 0.3, seed};
+            gen.AddMap();
+            gen.AddMap();
+            const std::vector<MapState> maps{{0, 100}, {10, 50}};
+            std::vector<unsigned> generated(2);
+            std::vector<unsigned> history;
+            for (int i = 0; i < 50; ++i) {
+                gen.Generate(300ms, maps, generated);
+                history.insert(history.end(), generated.begin(), generated.end());
+            }
+            std::vector<double> positions(10);
+            gen.FillUniform(positions);
+            return std::pair{history, positions};
+        };
+
+        THEN("the same seed reproduces loot and positions") {
+            CHECK(run(1) == run(1));
+            CHECK(run(1) != run(2));
+        }
+    }
+}
+
+SCENARIO("Xoshiro random generator") {
+    GIVEN("a generator") {
+        loot_gen::Xoshiro256PlusPlus random{0};
+
+        THEN("doubles are in range [0, 1) and fill the range") {
+            double min = 1.0;
+            double max = 0.0;
+            for (int i = 0; i < 10000; ++i) {
+                const double value = random.NextDouble();
+                min = std::min(min, value);
+                max = std::max(max, value);
+            }
+            CHECK(min >= 0.0);
+            CHECK(max < 1.0);
+            CHECK(min < 0.01);
+            CHECK(max > 0.99);
+        }
+
+        THEN("reseeding restarts the sequence") {
+            const auto first = random();
+            random();
+            random.Seed(0);
+            CHECK(random() == first);
+        }
+    }
+}
@@ -0,0 +1,109 @@
+#include "catalog_reader.h"
+
+#include <boost/algorithm/string/trim.hpp>
+#include <algorithm>
+#include <charconv>
+#include <istream>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace app {
+using namespace std::literals;
+
+namespace {
+
+// Разбирает строку CSV на поля. Выбрасывает std::invalid_argument, если кавычки не закрыты
+std::vector<std::string> SplitCsvLine(std::string_view line) {
+    std::vector<std::string> fields(1);
+    bool quoted = false;
+    for (size_t i = 0; i < line.size(); ++i) {
+        const char c = line[i];
+        if (quoted) {
+            if (c != '"') {
+                fields.back() += c;
+            } else if (i + 1 < line.size() && line[i + 1] == '"') {
+                fields.back() += '"';
+                ++i;
+            } else {
+                quoted = false;
+            }
+        } else if (c == '"') {
+            quoted = true;
+        } else if (c == ',') {
+            fields.emplace_back();
+        } else {
+            fields.back() += c;
+        }
+    }
+    if (quoted) {
+        throw std::invalid_argument("Unterminated quoted field");
+    }
+    return fields;
+}
+
+// Считает символы UTF-8, пропуская байты продолжения вида 10xxxxxx
+size_t CountUtf8Chars(std::string_view text) {
+    return std::count_if(text.begin(), text.end(), [](char c) {
+        return (static_cast<unsigned char>(c) & 0xC0) != 0x80;
+    });
+}
+
+void CheckNameLength(std::string_view text, std::string_view what) {
+    if (CountUtf8Chars(text) > MAX_CATALOG_NAME_LENGTH) {
+        throw std::invalid_argument(std::string{what} + " is longer than "s
+                                    + std::to_string(MAX_CATALOG_NAME_LENGTH) + " characters"s);
+    }
+}
+
+int ParseYear(std::string_view text) {
+    int year = 0;
+    const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), year);
+    if (ec != std::errc{} || end != text.data() + text.size()) {
+        throw std::invalid_argument("Invalid publication year");
+    }
+    return year;
+}
+
+}  // namespace
+
+std::optional<CatalogRecord> CsvCatalogReader::Next() {
+    while (std::getline(input_, line_)) {
+        ++line_number_;
+        if (!line_.empty() && line_.back() == '\r') {
+            line_.pop_back();
+        }
+        if (line_.empty()) {
+            continue;
+        }
+
+        try {
+            auto fields = SplitCsvLine(line_);
+            for (auto& field : fields) {
+                boost::algorithm::trim(field);
+            }
+            if (fields.size() != 1 && fields.size() != 3) {
+                throw std::invalid_argument("Expected author, title and publication year");
+            }
+            if (fields[0].empty()) {
+                throw std::invalid_argument("Author name is empty");
+            }
+            CheckNameLength(fields[0], "Author name"sv);
+
+            CatalogRecord record{std::move(fields[0]), std::nullopt};
+            if (fields.size() == 3 && (!fields[1].empty() || !fields[2].empty())) {
+                if (fields[1].empty()) {
+                    throw std::invalid_argument("Book title is empty");
+                }
+                CheckNameLength(fields[1], "Book title"sv);
+                record.book = CatalogRecord::BookInfo{std::move(fields[1]), ParseYear(fields[2])};
+            }
+            return record;
+        } catch (const std::invalid_argument& e) {
+            throw std::invalid_argument("Line "s + std::to_string(line_number_) + ": "s + e.what());
+        }
+    }
+    return std::nullopt;
+}
+
+}  // namespace app
@@ -0,0 +1,46 @@
+#pragma once
+#include <cstddef>
+#include <iosfwd>
+#include <optional>
+#include <string>
+
+namespace app {
+
+// Наибольшая длина имени автора и названия книги в символах, как в столбцах базы данных
+inline constexpr size_t MAX_CATALOG_NAME_LENGTH = 100;
+
+struct CatalogRecord {
+    struct BookInfo {
+        std::string title;
+        int publication_year = 0;
+    };
+
+    std::string author_name;
+    std::optional<BookInfo> book;
+};
+
+/*
+ * Читает каталог в формате CSV по одной записи на строку:
+ *   author,title,publication_year
+ * Для автора без книги title и publication_year пусты. Имя и название в кодировке UTF-8
+ * не длиннее MAX_CATALOG_NAME_LENGTH символов. Поля с запятыми или кавычками
+ * заключаются в кавычки, а кавычка внутри такого поля удваивается.
+ * Пустые строки пропускаются
+ */
+class CsvCatalogReader {
+public:
+    explicit CsvCatalogReader(std::istream& input)
+        : input_{input} {
+    }
+
+    // Возвращает std::nullopt в конце файла.
+    // Выбрасывает std::invalid_argument с номером строки, если запись некорректна
+    std::optional<CatalogRecord> Next();
+
+private:
+    std::istream& input_;
+    std::string line_;
+    size_t line_number_ = 0;
+};
+
+}  // namespace app
@@ -0,0 +1,32 @@
+#pragma once
+#include <memory>
+
+#include "../domain/author_fwd.h"
+
+namespace app {
+
+/*
+ * Единица работы: операции с репозиториями, выполняемые в одной транзакции.
+ * Изменения сохраняются вызовом Commit, а единица работы, разрушенная без него,
+ * отменяет их
+ */
+class UnitOfWork {
+public:
+    virtual domain::AuthorRepository& Authors() = 0;
+
+    virtual domain::CatalogImport& CatalogImport() = 0;
+
+    virtual void Commit() = 0;
+
+    virtual ~UnitOfWork() = default;
+};
+
+class UnitOfWorkFactory {
+public:
+    virtual std::unique_ptr<UnitOfWork> CreateUnitOfWork() = 0;
+
+protected:
+    ~UnitOfWorkFactory() = default;
+};
+
+}  // namespace app
@@ -1,6 +1,10 @@
 #pragma once
 
+#include <iosfwd>
 #include <string>
+#include <vector>
+
+#include "../domain/catalog_import.h"
 
 namespace app {
 
@@ -8,6 +12,15 @@ class UseCases {
 public:
     virtual void AddAuthor(const std::string& name) = 0;
 
+    // Добавляет всех авторов в одной транзакции: либо все, либо ни одного
+    virtual void AddAuthors(const std::vector<std::string>& names) = 0;
+
+    /*
+     * Загружает авторов и книги из каталога в формате CSV (см. CsvCatalogReader)
+     * в одной транзакции. Каталог читается потоково и не загружается в память целиком
+     */
+    virtual domain::CatalogImportResult ImportCatalog(std::istream& input) = 0;
+
 protected:
     ~UseCases() = default;
 };
@@ -1,12 +1,47 @@
 #include "use_cases_impl.h"
 
+#include <optional>
+
 #include "../domain/author.h"
+#include "../domain/book.h"
+#include "catalog_reader.h"
 
 namespace app {
 using namespace domain;
 
 void UseCasesImpl::AddAuthor(const std::string& name) {
-    authors_.Save({AuthorId::New(), name});
+    auto unit_of_work = unit_of_work_factory_.CreateUnitOfWork();
+    unit_of_work->Authors().Save({AuthorId::New(), name});
+    unit_of_work->Commit();
+}
+
+void UseCasesImpl::AddAuthors(const std::vector<std::string>& names) {
+    auto unit_of_work = unit_of_work_factory_.CreateUnitOfWork();
+    auto& authors = unit_of_work->Authors();
+    for (const std::string& name : names) {
+        authors.Save({AuthorId::New(), name});
+    }
+    unit_of_work->Commit();
+}
+
+CatalogImportResult UseCasesImpl::ImportCatalog(std::istream& input) {
+    auto unit_of_work = unit_of_work_factory_.CreateUnitOfWork();
+    auto& catalog = unit_of_work->CatalogImport();
+    CsvCatalogReader reader{input};
+    // Идентификаторы создаются здесь, без обращения к базе данных.
+    // Повторяющиеся в каталоге авторы и книги сливаются при загрузке по имени и названию
+    while (auto record = reader.Next()) {
+        const Author author{AuthorId::New(), std::move(record->author_name)};
+        std::optional<Book> book;
+        if (record->book) {
+            book.emplace(BookId::New(), author.GetId(), std::move(record->book->title),
+                         record->book->publication_year);
+        }
+        catalog.Add(author, book);
+    }
+    const auto result = catalog.Finish();
+    unit_of_work->Commit();
+    return result;
 }
 
 }  // namespace app
@@ -1,19 +1,23 @@
 #pragma once
-#include "../domain/author_fwd.h"
+#include "unit_of_work.h"
 #include "use_cases.h"
 
 namespace app {
 
 class UseCasesImpl : public UseCases {
 public:
-    explicit UseCasesImpl(domain::AuthorRepository& authors)
-        : authors_{authors} {
+    explicit UseCasesImpl(UnitOfWorkFactory& unit_of_work_factory)
+        : unit_of_work_factory_{unit_of_work_factory} {
     }
 
     void AddAuthor(const std::string& name) override;
 
+    void AddAuthors(const std::vector<std::string>& names) override;
+
+    domain::CatalogImportResult ImportCatalog(std::istream& input) override;
+
 private:
-    domain::AuthorRepository& authors_;
+    UnitOfWorkFactory& unit_of_work_factory_;
 };
 
 }  // namespace app
@@ -11,7 +11,7 @@ namespace bookypedia {
 using namespace std::literals;
 
 Application::Application(const AppConfig& config)
-    : db_{pqxx::connection{config.db_url}} {
+    : db_{config.db_url, config.db_connection_count} {
 }
 
 void Application::Run() {
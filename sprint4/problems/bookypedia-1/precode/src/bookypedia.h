@@ -8,6 +8,8 @@ namespace bookypedia {
 
 struct AppConfig {
     std::string db_url;
+    // Сколько соединений с базой данных могут одновременно использовать рабочие потоки
+    size_t db_connection_count = postgres::Database::DEFAULT_CONNECTION_COUNT;
 };
 
 class Application {
@@ -18,7 +20,7 @@ public:
 
 private:
     postgres::Database db_;
-    app::UseCasesImpl use_cases_{db_.GetAuthors()};
+    app::UseCasesImpl use_cases_{db_};
 };
 
 }  // namespace bookypedia
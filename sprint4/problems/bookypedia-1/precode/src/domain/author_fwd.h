@@ -6,4 +6,6 @@ class Author;
 
 class AuthorRepository;
 
+class CatalogImport;
+
 }  // namespace domain
\ No newline at end of file
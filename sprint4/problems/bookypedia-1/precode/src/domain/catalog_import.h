@@ -0,0 +1,31 @@
+#pragma once
+#include <cstddef>
+#include <optional>
+
+#include "author.h"
+#include "book.h"
+
+namespace domain {
+
+struct CatalogImportResult {
+    size_t authors_added = 0;
+    size_t books_added = 0;
+};
+
+/*
+ * Массовая загрузка авторов и книг. Добавленное сохраняется только после Finish.
+ * Автор, имя которого уже есть в каталоге, не добавляется повторно,
+ * а его книги достаются уже существующему автору с этим именем
+ */
+class CatalogImport {
+public:
+    // Добавляет автора и, если задана, его книгу. book.GetAuthorId() должен совпадать с author.GetId()
+    virtual void Add(const Author& author, const std::optional<Book>& book) = 0;
+
+    virtual CatalogImportResult Finish() = 0;
+
+protected:
+    ~CatalogImport() = default;
+};
+
+}  // namespace domain
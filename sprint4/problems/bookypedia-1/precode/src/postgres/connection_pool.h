@@ -0,0 +1,141 @@
+#pragma once
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace postgres {
+
+class ConnectionPoolTimeout : public std::runtime_error {
+public:
+    using runtime_error::runtime_error;
+};
+
+/*
+ * Пул не более чем из capacity соединений, разделяемый рабочими потоками.
+ * Соединение выдаётся во временное пользование и возвращается в пул при разрушении
+ * ConnectionWrapper. Соединения создаются фабрикой лениво, по мере надобности.
+ * Перед выдачей соединение проверяется, и закрытое (например, разорванное сервером)
+ * заменяется новым.
+ * Connection должен иметь метод bool is_open() const, как pqxx::connection
+ */
+template <typename Connection>
+class BasicConnectionPool {
+public:
+    using ConnectionFactory = std::function<std::unique_ptr<Connection>()>;
+
+    static constexpr std::chrono::milliseconds DEFAULT_WAIT_TIMEOUT{5000};
+
+    class ConnectionWrapper {
+    public:
+        ConnectionWrapper(std::unique_ptr<Connection>&& conn, BasicConnectionPool& pool) noexcept
+            : conn_{std::move(conn)}
+            , pool_{&pool} {
+        }
+
+        ConnectionWrapper(const ConnectionWrapper&) = delete;
+        ConnectionWrapper& operator=(const ConnectionWrapper&) = delete;
+
+        ConnectionWrapper(ConnectionWrapper&&) = default;
+        ConnectionWrapper& operator=(ConnectionWrapper&&) = delete;
+
+        Connection& operator*() const noexcept {
+            return *conn_;
+        }
+
+        Connection* operator->() const noexcept {
+            return conn_.get();
+        }
+
+        ~ConnectionWrapper() {
+            if (conn_) {
+                pool_->ReturnConnection(std::move(conn_));
+            }
+        }
+
+    private:
+        std::unique_ptr<Connection> conn_;
+        BasicConnectionPool* pool_;
+    };
+
+    BasicConnectionPool(size_t capacity, ConnectionFactory connection_factory)
+        : capacity_{capacity}
+        , connection_factory_{std::move(connection_factory)} {
+        if (capacity == 0) {
+            throw std::invalid_argument("Connection pool capacity must be positive");
+        }
+        idle_connections_.reserve(capacity);
+    }
+
+    BasicConnectionPool(const BasicConnectionPool&) = delete;
+    BasicConnectionPool& operator=(const BasicConnectionPool&) = delete;
+
+    /*
+     * Выдаёт соединение, дожидаясь его освобождения не дольше timeout.
+     * Выбрасывает ConnectionPoolTimeout, если все соединения так и остались заняты,
+     * и пробрасывает исключение фабрики, если не удалось установить соединение
+     */
+    ConnectionWrapper GetConnection(std::chrono::milliseconds timeout = DEFAULT_WAIT_TIMEOUT) {
+        std::unique_ptr<Connection> conn;
+        {
+            std::unique_lock lock{mutex_};
+            if (!cond_var_.wait_for(lock, timeout, [this] {
+                    return leased_count_ < capacity_;
+                })) {
+                throw ConnectionPoolTimeout("Timed out waiting for a database connection");
+            }
+            ++leased_count_;
+            if (!idle_connections_.empty()) {
+                conn = std::move(idle_connections_.back());
+                idle_connections_.pop_back();
+            }
+        }
+
+        // Соединение устанавливается вне блокировки, чтобы не задерживать другие потоки
+        if (!conn || !conn->is_open()) {
+            try {
+                conn = connection_factory_();
+            } catch (...) {
+                ReleaseSlot();
+                throw;
+            }
+        }
+        return ConnectionWrapper{std::move(conn), *this};
+    }
+
+    size_t GetCapacity() const noexcept {
+        return capacity_;
+    }
+
+private:
+    void ReturnConnection(std::unique_ptr<Connection>&& conn) {
+        {
+            std::lock_guard lock{mutex_};
+            assert(leased_count_ > 0);
+            --leased_count_;
+            idle_connections_.push_back(std::move(conn));
+        }
+        cond_var_.notify_one();
+    }
+
+    void ReleaseSlot() {
+        {
+            std::lock_guard lock{mutex_};
+            --leased_count_;
+        }
+        cond_var_.notify_one();
+    }
+
+    const size_t capacity_;
+    ConnectionFactory connection_factory_;
+    std::mutex mutex_;
+    std::condition_variable cond_var_;
+    std::vector<std::unique_ptr<Connection>> idle_connections_;
+    size_t leased_count_ = 0;
+};
+
+}  // namespace postgres
@@ -1,40 +1,154 @@
 #include "postgres.h"
 
 #include <pqxx/zview.hxx>
+#include <memory>
+#include <stdexcept>
+
+#include "prepared_statements.h"
 
 namespace postgres {
 
 using namespace std::literals;
 using pqxx::operator"" _zv;
 
+void StatementPipeline::Insert(const std::string& query) {
+    if (!pipeline_) {
+        pipeline_.emplace(work_);
+        pipeline_->retain(BATCH_SIZE);
+    }
+    pipeline_->insert(query);
+}
+
+void StatementPipeline::Finish() {
+    if (!pipeline_) {
+        return;
+    }
+    // retrieve выбрасывает исключение, если запрос завершился ошибкой
+    while (!pipeline_->empty()) {
+        pipeline_->retrieve();
+    }
+    pipeline_->complete();
+    pipeline_.reset();
+}
+
 void AuthorRepositoryImpl::Save(const domain::Author& author) {
-    // Пока каждое обращение к репозиторию выполняется внутри отдельной транзакции
-    // В будущих уроках вы узнаете про паттерн Unit of Work, при помощи которого сможете несколько
-    // запросов выполнить в рамках одной транзакции.
-    // Вы также может самостоятельно почитать информацию про этот паттерн и применить его здесь.
-    pqxx::work work{connection_};
-    work.exec_params(
-        R"(
-INSERT INTO authors (id, name) VALUES ($1, $2)
-ON CONFLICT (id) DO UPDATE SET name=$2;
-)"_zv,
-        author.GetId().ToString(), author.GetName());
-    work.commit();
+    pipeline_.Insert(MakeExecuteCommand(work_, statements::SAVE_AUTHOR, author.GetId().ToString(),
+                                        author.GetName()));
+}
+
+void CatalogImportImpl::Add(const domain::Author& author, const std::optional<domain::Book>& book) {
+    if (book && book->GetAuthorId() != author.GetId()) {
+        throw std::invalid_argument("Book "s + book->GetTitle() + " belongs to another author"s);
+    }
+    if (!stream_) {
+        // COPY, как и конвейер, занимает транзакцию целиком
+        pipeline_.Finish();
+        // Временные таблицы не видны при подготовке запросов соединения, поэтому
+        // запросы к catalog_import выполняются текстом.
+        // Столбец position хранит порядок записей в каталоге
+        work_.exec(R"(
+CREATE TEMP TABLE IF NOT EXISTS catalog_import (
+    position bigserial,
+    author_id UUID NOT NULL,
+    author_name varchar(100) NOT NULL,
+    book_id UUID,
+    title varchar(100),
+    publication_year integer
+) ON COMMIT DROP;
+)"_zv);
+        stream_.emplace(pqxx::stream_to::table(
+            work_, {"catalog_import"sv},
+            {"author_id"sv, "author_name"sv, "book_id"sv, "title"sv, "publication_year"sv}));
+    }
+
+    std::optional<std::string> book_id;
+    std::optional<std::string> title;
+    std::optional<int> publication_year;
+    if (book) {
+        book_id = book->GetId().ToString();
+        title = book->GetTitle();
+        publication_year = book->GetPublicationYear();
+    }
+    stream_->write_values(author.GetId().ToString(), author.GetName(), book_id, title, publication_year);
+}
+
+domain::CatalogImportResult CatalogImportImpl::Finish() {
+    if (!stream_) {
+        return {};
+    }
+    stream_->complete();
+    stream_.reset();
+
+    domain::CatalogImportResult result;
+    // Из повторяющихся в каталоге имён берётся первое, а уже известные авторы пропускаются
+    result.authors_added = work_.exec(R"(
+INSERT INTO authors (id, name)
+SELECT DISTINCT ON (author_name) author_id, author_name FROM catalog_import
+ORDER BY author_name, position
+ON CONFLICT DO NOTHING;
+)"_zv).affected_rows();
+    // Книги достаются автору с тем же именем, добавленному только что или раньше.
+    // Из книг автора с одинаковым названием берётся первая, а уже известные пропускаются,
+    // поэтому повторный импорт каталога не добавляет книг
+    result.books_added = work_.exec(R"(
+INSERT INTO books (id, author_id, title, publication_year)
+SELECT DISTINCT ON (a.id, i.title) i.book_id, a.id, i.title, i.publication_year
+FROM catalog_import i JOIN authors a ON a.name = i.author_name
+WHERE i.book_id IS NOT NULL
+ORDER BY a.id, i.title, i.position
+ON CONFLICT (author_id, title) DO NOTHING;
+)"_zv).affected_rows();
+    // Таблица остаётся до конца транзакции и может понадобиться следующему импорту
+    work_.exec("TRUNCATE catalog_import;"_zv);
+    return result;
+}
+
+UnitOfWorkImpl::UnitOfWorkImpl(ConnectionPool::ConnectionWrapper connection)
+    : connection_{std::move(connection)}
+    , work_{*connection_} {
 }
 
-Database::Database(pqxx::connection connection)
-    : connection_{std::move(connection)} {
-    pqxx::work work{connection_};
+void UnitOfWorkImpl::Commit() {
+    pipeline_.Finish();
+    work_.commit();
+}
+
+Database::Database(std::string db_url, size_t connection_count)
+    : connection_pool_{connection_count, [db_url] {
+                           auto connection = std::make_unique<pqxx::connection>(db_url);
+                           PrepareStatements(*connection);
+                           return connection;
+                       }} {
+    // Таблицы создаются на отдельном соединении: соединения пула при создании
+    // готовят запросы, которым нужны уже существующие таблицы
+    pqxx::connection connection{db_url};
+    pqxx::work work{connection};
     work.exec(R"(
 CREATE TABLE IF NOT EXISTS authors (
     id UUID CONSTRAINT author_id_constraint PRIMARY KEY,
     name varchar(100) UNIQUE NOT NULL
 );
 )"_zv);
-    // ... создать другие таблицы
+    work.exec(R"(
+CREATE TABLE IF NOT EXISTS books (
+    id UUID CONSTRAINT book_id_constraint PRIMARY KEY,
+    author_id UUID NOT NULL REFERENCES authors (id),
+    title varchar(100) NOT NULL,
+    publication_year integer
+);
+)"_zv);
+    // Книга определяется автором и названием. Индекс, а не ограничение в CREATE TABLE,
+    // добавляется и к таблице, созданной раньше
+    work.exec(R"(
+CREATE UNIQUE INDEX IF NOT EXISTS book_author_title_index ON books (author_id, title);
+)"_zv);
 
     // коммитим изменения
     work.commit();
 }
 
-}  // namespace postgres
\ No newline at end of file
+std::unique_ptr<app::UnitOfWork> Database::CreateUnitOfWork() {
+    return std::make_unique<UnitOfWorkImpl>(connection_pool_.GetConnection());
+}
+
+}  // namespace postgres
@@ -1,34 +1,118 @@
 #pragma once
+#include <optional>
 #include <pqxx/connection>
+#include <pqxx/pipeline>
+#include <pqxx/stream_to>
 #include <pqxx/transaction>
 
+#include "../app/unit_of_work.h"
 #include "../domain/author.h"
+#include "../domain/catalog_import.h"
+#include "connection_pool.h"
 
 namespace postgres {
 
+using ConnectionPool = BasicConnectionPool<pqxx::connection>;
+
+/*
+ * Конвейер запросов транзакции (pqxx::pipeline), открываемый при первом запросе.
+ * Запросы отправляются без ожидания ответа на каждый. Пока конвейер открыт,
+ * другие запросы в транзакции выполнять нельзя, поэтому перед ними вызывается Finish
+ */
+class StatementPipeline {
+public:
+    // Сколько запросов конвейер накапливает перед отправкой на сервер
+    static constexpr int BATCH_SIZE = 256;
+
+    explicit StatementPipeline(pqxx::work& work)
+        : work_{work} {
+    }
+
+    void Insert(const std::string& query);
+
+    // Дожидается выполнения запросов и закрывает конвейер.
+    // Выбрасывает исключение pqxx, если какой-то из запросов завершился ошибкой
+    void Finish();
+
+private:
+    pqxx::work& work_;
+    std::optional<pqxx::pipeline> pipeline_;
+};
+
 class AuthorRepositoryImpl : public domain::AuthorRepository {
 public:
-    explicit AuthorRepositoryImpl(pqxx::connection& connection)
-        : connection_{connection} {
+    AuthorRepositoryImpl(pqxx::work& work, StatementPipeline& pipeline)
+        : work_{work}
+        , pipeline_{pipeline} {
     }
 
     void Save(const domain::Author& author) override;
 
 private:
-    pqxx::connection& connection_;
+    pqxx::work& work_;
+    StatementPipeline& pipeline_;
+};
+
+/*
+ * Загружает записи каталога командой COPY (pqxx::stream_to) во временную таблицу,
+ * удаляемую при завершении транзакции, а затем переносит их в authors и books
+ * двумя запросами. Совпадения имён авторов разрешаются при переносе
+ */
+class CatalogImportImpl : public domain::CatalogImport {
+public:
+    CatalogImportImpl(pqxx::work& work, StatementPipeline& pipeline)
+        : work_{work}
+        , pipeline_{pipeline} {
+    }
+
+    void Add(const domain::Author& author, const std::optional<domain::Book>& book) override;
+
+    domain::CatalogImportResult Finish() override;
+
+private:
+    pqxx::work& work_;
+    StatementPipeline& pipeline_;
+    std::optional<pqxx::stream_to> stream_;
 };
 
-class Database {
+/*
+ * Единица работы занимает соединение из пула на время своей транзакции,
+ * поэтому единицы работы можно независимо использовать из разных потоков
+ */
+class UnitOfWorkImpl : public app::UnitOfWork {
 public:
-    explicit Database(pqxx::connection connection);
+    explicit UnitOfWorkImpl(ConnectionPool::ConnectionWrapper connection);
 
-    AuthorRepositoryImpl& GetAuthors() & {
+    domain::AuthorRepository& Authors() override {
         return authors_;
     }
 
+    domain::CatalogImport& CatalogImport() override {
+        return catalog_import_;
+    }
+
+    // Дожидается выполнения всех запросов конвейера и фиксирует транзакцию.
+    // Выбрасывает исключение pqxx, если какой-то из запросов завершился ошибкой
+    void Commit() override;
+
+private:
+    ConnectionPool::ConnectionWrapper connection_;
+    pqxx::work work_;
+    StatementPipeline pipeline_{work_};
+    AuthorRepositoryImpl authors_{work_, pipeline_};
+    CatalogImportImpl catalog_import_{work_, pipeline_};
+};
+
+class Database : public app::UnitOfWorkFactory {
+public:
+    static constexpr size_t DEFAULT_CONNECTION_COUNT = 8;
+
+    explicit Database(std::string db_url, size_t connection_count = DEFAULT_CONNECTION_COUNT);
+
+    std::unique_ptr<app::UnitOfWork> CreateUnitOfWork() override;
+
 private:
-    pqxx::connection connection_;
-    AuthorRepositoryImpl authors_{connection_};
+    ConnectionPool connection_pool_;
 };
 
-}  // namespace postgres
\ No newline at end of file
+}  // namespace postgres
@@ -0,0 +1,30 @@
+#include "prepared_statements.h"
+
+namespace postgres {
+
+using pqxx::operator"" _zv;
+
+namespace {
+
+struct StatementInfo {
+    pqxx::zview name;
+    pqxx::zview sql;
+};
+
+// Все запросы, которые выполняют репозитории
+constexpr StatementInfo STATEMENTS[] = {
+    {statements::SAVE_AUTHOR, R"(
+INSERT INTO authors (id, name) VALUES ($1, $2)
+ON CONFLICT (id) DO UPDATE SET name=$2;
+)"_zv},
+};
+
+}  // namespace
+
+void PrepareStatements(pqxx::connection& connection) {
+    for (const auto& [name, sql] : STATEMENTS) {
+        connection.prepare(name, sql);
+    }
+}
+
+}  // namespace postgres
@@ -0,0 +1,38 @@
+#pragma once
+#include <pqxx/connection>
+#include <pqxx/transaction>
+#include <pqxx/zview.hxx>
+#include <string>
+
+namespace postgres {
+
+// Имена подготовленных запросов репозиториев
+namespace statements {
+
+inline constexpr pqxx::zview SAVE_AUTHOR{"save_author"};
+
+}  // namespace statements
+
+/*
+ * Готовит на соединении все запросы репозиториев. Пул вызывает её для каждого нового
+ * соединения, в том числе заменившего разорванное, поэтому сервер разбирает и планирует
+ * каждый запрос один раз на соединение, а не при каждом выполнении.
+ * Таблицы, к которым обращаются запросы, должны уже существовать
+ */
+void PrepareStatements(pqxx::connection& connection);
+
+/*
+ * Возвращает SQL-команду EXECUTE, выполняющую подготовленный запрос name с параметрами args.
+ * Нужна для pqxx::pipeline, который принимает только текст запроса
+ */
+template <typename... Args>
+std::string MakeExecuteCommand(const pqxx::work& work, pqxx::zview name, const Args&... args) {
+    std::string command = "EXECUTE ";
+    command += work.quote_name(name);
+    char separator = '(';
+    ((command += separator, command += work.quote(args), separator = ','), ...);
+    command += sizeof...(Args) > 0 ? ");" : ";";
+    return command;
+}
+
+}  // namespace postgres
@@ -2,6 +2,7 @@
 
 #include <boost/algorithm/string/trim.hpp>
 #include <cassert>
+#include <fstream>
 #include <iostream>
 
 #include "../app/use_cases.h"
@@ -45,6 +46,8 @@ View::View(menu::Menu& menu, app::UseCases& use_cases, std::istream& input, std:
     );
     menu_.AddAction("AddBook"s, "<pub year> <title>"s, "Adds book"s,
                     std::bind(&View::AddBook, this, ph::_1));
+    menu_.AddAction("ImportCatalog"s, "<csv file>"s, "Imports authors and books from file"s,
+                    std::bind(&View::ImportCatalog, this, ph::_1));
     menu_.AddAction("ShowAuthors"s, {}, "Show authors"s, std::bind(&View::ShowAuthors, this));
     menu_.AddAction("ShowBooks"s, {}, "Show books"s, std::bind(&View::ShowBooks, this));
     menu_.AddAction("ShowAuthorBooks"s, {}, "Show author books"s,
@@ -74,6 +77,24 @@ bool View::AddBook(std::istream& cmd_input) const {
     return true;
 }
 
+bool View::ImportCatalog(std::istream& cmd_input) const {
+    try {
+        std::string path;
+        std::getline(cmd_input, path);
+        boost::algorithm::trim(path);
+        std::ifstream file{path};
+        if (!file) {
+            throw std::runtime_error("Failed to open "s + path);
+        }
+        const auto result = use_cases_.ImportCatalog(file);
+        output_ << "Authors added: "sv << result.authors_added << ", books added: "sv
+                << result.books_added << std::endl;
+    } catch (const std::exception& e) {
+        output_ << "Failed to import catalog: "sv << e.what() << std::endl;
+    }
+    return true;
+}
+
 bool View::ShowAuthors() const {
     PrintVector(output_, GetAuthors());
     return true;
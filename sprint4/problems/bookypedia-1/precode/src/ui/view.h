@@ -40,6 +40,7 @@ public:
 private:
     bool AddAuthor(std::istream& cmd_input) const;
     bool AddBook(std::istream& cmd_input) const;
+    bool ImportCatalog(std::istream& cmd_input) const;
     bool ShowAuthors() const;
     bool ShowBooks() const;
     bool ShowAuthorBooks() const;
@@ -0,0 +1,90 @@
+#include <catch2/catch_test_macros.hpp>
+#include <sstream>
+#include <stdexcept>
+
+#include "../src/app/catalog_reader.h"
+
+using namespace std::literals;
+
+SCENARIO("CSV catalog reading") {
+    GIVEN("a catalog with authors and books") {
+        std::istringstream input{
+            "Leo Tolstoy, War and Peace, 1869\r\n"
+            "\n"
+            "Anton Chekhov\n"
+            "\"Strugatsky, Arkady\",\"Roadside \"\"Picnic\"\"\",1972\n"
+            "Mikhail Bulgakov,,\n"};
+        app::CsvCatalogReader reader{input};
+
+        WHEN("records are read") {
+            THEN("fields are trimmed and unquoted") {
+                auto record = reader.Next();
+                REQUIRE(record);
+                CHECK(record->author_name == "Leo Tolstoy"s);
+                REQUIRE(record->book);
+                CHECK(record->book->title == "War and Peace"s);
+                CHECK(record->book->publication_year == 1869);
+
+                record = reader.Next();
+                REQUIRE(record);
+                CHECK(record->author_name == "Anton Chekhov"s);
+                CHECK(!record->book);
+
+                record = reader.Next();
+                REQUIRE(record);
+                CHECK(record->author_name == "Strugatsky, Arkady"s);
+                REQUIRE(record->book);
+                CHECK(record->book->title == "Roadside \"Picnic\""s);
+
+                record = reader.Next();
+                REQUIRE(record);
+                CHECK(record->author_name == "Mikhail Bulgakov"s);
+                CHECK(!record->book);
+
+                CHECK(!reader.Next());
+            }
+        }
+    }
+
+    GIVEN("malformed records") {
+        const auto read_first = [](const std::string& text) {
+            std::istringstream input{text};
+            return app::CsvCatalogReader{input}.Next();
+        };
+
+        THEN("reading fails") {
+            CHECK_THROWS_AS(read_first("Leo Tolstoy,War and Peace\n"), std::invalid_argument);
+            CHECK_THROWS_AS(read_first("Leo Tolstoy,War and Peace,18x9\n"), std::invalid_argument);
+            CHECK_THROWS_AS(read_first(",War and Peace,1869\n"), std::invalid_argument);
+            CHECK_THROWS_AS(read_first("\"Leo Tolstoy,War and Peace,1869\n"), std::invalid_argument);
+            CHECK_THROWS_AS(read_first("Leo Tolstoy,,1869\n"), std::invalid_argument);
+        }
+    }
+
+    GIVEN("names at the length limit of the database") {
+        const std::string max_name(app::MAX_CATALOG_NAME_LENGTH, 'a');
+        // Кириллица занимает два байта на символ, но длина считается в символах
+        std::string max_cyrillic_title;
+        for (size_t i = 0; i < app::MAX_CATALOG_NAME_LENGTH; ++i) {
+            max_cyrillic_title += "\u0436"s;
+        }
+
+        THEN("names of the maximum length are accepted") {
+            std::istringstream input{max_name + ","s + max_cyrillic_title + ",2000\n"s};
+            const auto record = app::CsvCatalogReader{input}.Next();
+            REQUIRE(record);
+            CHECK(record->author_name == max_name);
+            REQUIRE(record->book);
+            CHECK(record->book->title == max_cyrillic_title);
+        }
+
+        THEN("longer names are rejected with the line number") {
+            std::istringstream input{"Leo Tolstoy\n"s + max_name + "a\n"s + "Leo Tolstoy,"s
+                                     + max_cyrillic_title + "\u0436,2000\n"s};
+            app::CsvCatalogReader reader{input};
+            REQUIRE(reader.Next());
+            CHECK_THROWS_WITH(reader.Next(), "Line 2: Author name is longer than 100 characters");
+            CHECK_THROWS_WITH(reader.Next(), "Line 3: Book title is longer than 100 characters");
+        }
+    }
+}
@@ -0,0 +1,108 @@
+#include <catch2/catch_test_macros.hpp>
+#include <thread>
+
+#include "../src/postgres/connection_pool.h"
+
+using namespace std::literals;
+
+namespace {
+
+struct FakeConnection {
+    int id = 0;
+    bool open = true;
+
+    bool is_open() const noexcept {
+        return open;
+    }
+};
+
+using Pool = postgres::BasicConnectionPool<FakeConnection>;
+
+struct Fixture {
+    int created_count = 0;
+    bool factory_fails = false;
+
+    Pool::ConnectionFactory MakeFactory() {
+        return [this] {
+            if (factory_fails) {
+                throw std::runtime_error("Connection refused");
+            }
+            return std::make_unique<FakeConnection>(FakeConnection{++created_count});
+        };
+    }
+};
+
+}  // namespace
+
+SCENARIO_METHOD(Fixture, "Connection pool") {
+    GIVEN("a pool of two connections") {
+        Pool pool{2, MakeFactory()};
+
+        THEN("connections are not created until needed") {
+            CHECK(created_count == 0);
+        }
+
+        WHEN("a connection is returned to the pool") {
+            int first_id = 0;
+            {
+                auto conn = pool.GetConnection();
+                first_id = conn->id;
+            }
+            auto conn = pool.GetConnection();
+
+            THEN("it is reused") {
+                CHECK(conn->id == first_id);
+                CHECK(created_count == 1);
+            }
+        }
+
+        WHEN("all connections are leased") {
+            auto conn1 = pool.GetConnection();
+            auto conn2 = pool.GetConnection();
+
+            THEN("they are different") {
+                CHECK(conn1->id != conn2->id);
+            }
+
+            THEN("waiting for another one times out") {
+                CHECK_THROWS_AS(pool.GetConnection(10ms), postgres::ConnectionPoolTimeout);
+            }
+
+            THEN("a waiting thread gets the connection when it is returned") {
+                const int returned_id = conn1->id;
+                std::jthread returner{[conn = std::move(conn1)]() mutable {
+                    std::this_thread::sleep_for(20ms);
+                    auto returned = std::move(conn);
+                }};
+                auto conn3 = pool.GetConnection(10s);
+                CHECK(conn3->id == returned_id);
+            }
+        }
+
+        WHEN("an idle connection gets closed") {
+            {
+                auto conn = pool.GetConnection();
+                conn->open = false;
+            }
+            auto conn = pool.GetConnection();
+
+            THEN("it is replaced with a new one") {
+                CHECK(conn->is_open());
+                CHECK(created_count == 2);
+            }
+        }
+
+        WHEN("a connection can not be established") {
+            factory_fails = true;
+            CHECK_THROWS_AS(pool.GetConnection(), std::runtime_error);
+            CHECK_THROWS_AS(pool.GetConnection(), std::runtime_error);
+            factory_fails = false;
+
+            THEN("failed attempts do not occupy the pool") {
+                auto conn1 = pool.GetConnection(10ms);
+                auto conn2 = pool.GetConnection(10ms);
+                CHECK(created_count == 2);
+            }
+        }
+    }
+}
@@ -1,7 +1,9 @@
 #include <catch2/catch_test_macros.hpp>
+#include <sstream>
 
 #include "../src/app/use_cases_impl.h"
 #include "../src/domain/author.h"
+#include "../src/domain/book.h"
 
 namespace {
 
@@ -13,15 +15,77 @@ struct MockAuthorRepository : domain::AuthorRepository {
     }
 };
 
-struct Fixture {
+struct MockCatalogImport : domain::CatalogImport {
+    std::vector<domain::Author> added_authors;
+    std::vector<domain::Book> added_books;
+    int finish_count = 0;
+
+    void Add(const domain::Author& author, const std::optional<domain::Book>& book) override {
+        added_authors.emplace_back(author);
+        if (book) {
+            added_books.emplace_back(*book);
+        }
+    }
+
+    domain::CatalogImportResult Finish() override {
+        ++finish_count;
+        return {added_authors.size(), added_books.size()};
+    }
+};
+
+// Авторы попадают в общий репозиторий, только когда единица работы зафиксирована
+struct MockUnitOfWork : app::UnitOfWork {
+    MockUnitOfWork(MockAuthorRepository& committed_authors, MockCatalogImport& catalog_import,
+                   int& commit_count)
+        : committed_authors_{committed_authors}
+        , catalog_import_{catalog_import}
+        , commit_count_{commit_count} {
+    }
+
+    domain::AuthorRepository& Authors() override {
+        return authors_;
+    }
+
+    domain::CatalogImport& CatalogImport() override {
+        return catalog_import_;
+    }
+
+    void Commit() override {
+        for (const auto& author : authors_.saved_authors) {
+            committed_authors_.Save(author);
+        }
+        authors_.saved_authors.clear();
+        ++commit_count_;
+    }
+
+private:
+    MockAuthorRepository authors_;
+    MockAuthorRepository& committed_authors_;
+    MockCatalogImport& catalog_import_;
+    int& commit_count_;
+};
+
+struct MockUnitOfWorkFactory : app::UnitOfWorkFactory {
     MockAuthorRepository authors;
+    int commit_count = 0;
+    MockCatalogImport catalog_import;
+
+    std::unique_ptr<app::UnitOfWork> CreateUnitOfWork() override {
+        return std::make_unique<MockUnitOfWork>(authors, catalog_import, commit_count);
+    }
+};
+
+struct Fixture {
+    MockUnitOfWorkFactory unit_of_work_factory;
+    MockAuthorRepository& authors = unit_of_work_factory.authors;
+    MockCatalogImport& catalog_import = unit_of_work_factory.catalog_import;
 };
 
 }  // namespace
 
 SCENARIO_METHOD(Fixture, "Book Adding") {
     GIVEN("Use cases") {
-        app::UseCasesImpl use_cases{authors};
+        app::UseCasesImpl use_cases{unit_of_work_factory};
 
         WHEN("Adding an author") {
             const auto author_name = "Joanne Rowling";
@@ -33,5 +97,49 @@ SCENARIO_METHOD(Fixture, "Book Adding") {
                 CHECK(authors.saved_authors.at(0).GetId() != domain::AuthorId{});
             }
         }
+
+        WHEN("Adding several authors at once") {
+            use_cases.AddAuthors({"Leo Tolstoy", "Anton Chekhov"});
+
+            THEN("they are saved in a single unit of work") {
+                CHECK(unit_of_work_factory.commit_count == 1);
+                REQUIRE(authors.saved_authors.size() == 2);
+                CHECK(authors.saved_authors.at(0).GetName() == "Leo Tolstoy");
+                CHECK(authors.saved_authors.at(1).GetName() == "Anton Chekhov");
+                CHECK(authors.saved_authors.at(0).GetId() != authors.saved_authors.at(1).GetId());
+            }
+        }
+
+        WHEN("Importing a catalog") {
+            std::istringstream input{
+                "Leo Tolstoy,War and Peace,1869\n"
+                "Anton Chekhov\n"
+                "Leo Tolstoy,\"Anna Karenina\",1878\n"};
+            const auto result = use_cases.ImportCatalog(input);
+
+            THEN("every record is passed to the import in a single unit of work") {
+                CHECK(catalog_import.finish_count == 1);
+                CHECK(unit_of_work_factory.commit_count == 1);
+                CHECK(result.authors_added == 3);
+                CHECK(result.books_added == 2);
+                REQUIRE(catalog_import.added_authors.size() == 3);
+                CHECK(catalog_import.added_authors.at(1).GetName() == "Anton Chekhov");
+                REQUIRE(catalog_import.added_books.size() == 2);
+                CHECK(catalog_import.added_books.at(1).GetTitle() == "Anna Karenina");
+                CHECK(catalog_import.added_books.at(1).GetPublicationYear() == 1878);
+                CHECK(catalog_import.added_books.at(1).GetAuthorId()
+                      == catalog_import.added_authors.at(2).GetId());
+            }
+        }
+
+        WHEN("Importing a malformed catalog") {
+            std::istringstream input{"Leo Tolstoy,War and Peace,1869\nAnton Chekhov,Ivanov\n"};
+
+            THEN("nothing is committed") {
+                CHECK_THROWS_AS(use_cases.ImportCatalog(input), std::invalid_argument);
+                CHECK(catalog_import.finish_count == 0);
+                CHECK(unit_of_work_factory.commit_count == 0);
+            }
+        }
     }
-}
\ No newline at end of file
+}
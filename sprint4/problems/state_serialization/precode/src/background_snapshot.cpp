@@ -0,0 +1,81 @@
+#include "background_snapshot.h"
+
+#include <utility>
+
+namespace serialization {
+
+BackgroundSnapshotWriter::BackgroundSnapshotWriter(std::filesystem::path path)
+    : path_{std::move(path)}
+    , worker_{[this] {
+        Run();
+    }} {
+}
+
+BackgroundSnapshotWriter::~BackgroundSnapshotWriter() {
+    {
+        std::lock_guard lock{mutex_};
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    worker_.join();
+}
+
+void BackgroundSnapshotWriter::Schedule(std::vector<SessionSnapshot> sessions) {
+    std::optional<std::vector<SessionSnapshot>> outdated;
+    {
+        std::lock_guard lock{mutex_};
+        // Вытесненный снимок освобождается уже после снятия блокировки
+        outdated = std::exchange(pending_, std::move(sessions));
+    }
+    cv_.notify_all();
+}
+
+void BackgroundSnapshotWriter::Flush() {
+    std::unique_lock lock{mutex_};
+    cv_.wait(lock, [this] {
+        return !pending_ && !writing_;
+    });
+    if (error_) {
+        std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+}
+
+size_t BackgroundSnapshotWriter::GetWrittenCount() const {
+    std::lock_guard lock{mutex_};
+    return written_count_;
+}
+
+void BackgroundSnapshotWriter::Run() {
+    std::unique_lock lock{mutex_};
+    while (true) {
+        cv_.wait(lock, [this] {
+            return pending_ || stopping_;
+        });
+        if (!pending_) {
+            return;
+        }
+
+        auto sessions = std::move(*pending_);
+        pending_.reset();
+        writing_ = true;
+        lock.unlock();
+
+        std::exception_ptr error;
+        try {
+            SaveSnapshotFile(path_, sessions);
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        lock.lock();
+        writing_ = false;
+        if (error) {
+            error_ = error;
+        } else {
+            ++written_count_;
+        }
+        cv_.notify_all();
+    }
+}
+
+}  // namespace serialization
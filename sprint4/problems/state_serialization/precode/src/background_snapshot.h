@@ -0,0 +1,55 @@
+#pragma once
+#include <condition_variable>
+#include <exception>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "binary_snapshot.h"
+
+namespace serialization {
+
+/*
+ * Записывает снимки состояния в файл в отдельном потоке.
+ * Игровой поток на границе тика только снимает копию состояния (CaptureSession)
+ * и передаёт её сюда - сериализация и запись на диск идут параллельно с игрой.
+ * Если поток записи не успевает, ещё не начатый снимок заменяется более свежим.
+ */
+class BackgroundSnapshotWriter {
+public:
+    explicit BackgroundSnapshotWriter(std::filesystem::path path);
+
+    BackgroundSnapshotWriter(const BackgroundSnapshotWriter&) = delete;
+    BackgroundSnapshotWriter& operator=(const BackgroundSnapshotWriter&) = delete;
+
+    // Дописывает последний переданный снимок и останавливает поток записи
+    ~BackgroundSnapshotWriter();
+
+    // Передаёт снимок потоку записи. Занимает время перемещения вектора
+    void Schedule(std::vector<SessionSnapshot> sessions);
+
+    // Дожидается записи переданных снимков. Выбрасывает исключение,
+    // если запись какого-то из них после предыдущего вызова Flush завершилась ошибкой
+    void Flush();
+
+    // Сколько снимков записано успешно
+    size_t GetWrittenCount() const;
+
+private:
+    void Run();
+
+    std::filesystem::path path_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::optional<std::vector<SessionSnapshot>> pending_;
+    bool writing_ = false;
+    bool stopping_ = false;
+    size_t written_count_ = 0;
+    std::exception_ptr error_;
+    // Поток объявлен последним, чтобы запускаться после инициализации остальных полей
+    std::jthread worker_;
+};
+
+}  // namespace serialization
@@ -0,0 +1,123 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace serialization {
+
+/*
+ * Запись чисел и массивов чисел в порядке little-endian.
+ * На little-endian платформах массив пишется в поток одной операцией
+ */
+class BinaryWriter {
+public:
+    explicit BinaryWriter(std::ostream& out) noexcept
+        : out_{out} {
+    }
+
+    template <typename T>
+    void WriteValue(T value) {
+        WriteArray(std::span<const T>{&value, 1});
+    }
+
+    // range - непрерывный диапазон чисел: вектор, строка, std::span
+    template <typename Range>
+    void WriteArray(const Range& range) {
+        const std::span values{std::ranges::data(range), std::ranges::size(range)};
+        using T = std::remove_cv_t<typename decltype(values)::element_type>;
+        static_assert(std::is_arithmetic_v<T>);
+        if constexpr (std::endian::native == std::endian::little || sizeof(T) == 1) {
+            out_.write(reinterpret_cast<const char*>(values.data()),
+                       static_cast<std::streamsize>(values.size_bytes()));
+        } else {
+            for (T value : values) {
+                auto bytes = std::bit_cast<std::array<char, sizeof(T)>>(value);
+                std::reverse(bytes.begin(), bytes.end());
+                out_.write(bytes.data(), bytes.size());
+            }
+        }
+        if (!out_) {
+            throw std::runtime_error("Failed to write binary data");
+        }
+    }
+
+    void WriteString(const std::string& str) {
+        WriteValue<uint64_t>(str.size());
+        WriteArray(str);
+    }
+
+private:
+    std::ostream& out_;
+};
+
+/*
+ * Чтение данных, записанных BinaryWriter.
+ * Обрезанные данные приводят к исключению std::runtime_error
+ */
+class BinaryReader {
+public:
+    explicit BinaryReader(std::istream& in) noexcept
+        : in_{in} {
+    }
+
+    template <typename T>
+    T ReadValue() {
+        T value;
+        ReadInto(std::span<T>{&value, 1});
+        return value;
+    }
+
+    // Читает count элементов. Массив растёт частями, чтобы повреждённый размер
+    // приводил к ошибке чтения, а не к попытке выделить огромный блок памяти
+    template <typename Container>
+    void ReadArray(Container& values, uint64_t count) {
+        constexpr uint64_t CHUNK_SIZE = 1 << 16;
+        values.clear();
+        while (values.size() < count) {
+            const size_t old_size = values.size();
+            values.resize(old_size + std::min(CHUNK_SIZE, count - old_size));
+            ReadInto(std::span{values}.subspan(old_size));
+        }
+    }
+
+    std::string ReadString() {
+        std::string str;
+        ReadArray(str, ReadValue<uint64_t>());
+        return str;
+    }
+
+    // true, если данные закончились ровно на границе записи
+    bool AtEnd() {
+        return in_.peek() == std::istream::traits_type::eof();
+    }
+
+private:
+    template <typename T>
+    void ReadInto(std::span<T> values) {
+        static_assert(std::is_arithmetic_v<T>);
+        const auto size = static_cast<std::streamsize>(values.size_bytes());
+        if (!in_.read(reinterpret_cast<char*>(values.data()), size)) {
+            throw std::runtime_error("Unexpected end of binary data");
+        }
+        if constexpr (std::endian::native != std::endian::little && sizeof(T) > 1) {
+            for (T& value : values) {
+                auto bytes = std::bit_cast<std::array<char, sizeof(T)>>(value);
+                std::reverse(bytes.begin(), bytes.end());
+                value = std::bit_cast<T>(bytes);
+            }
+        }
+    }
+
+    std::istream& in_;
+};
+
+}  // namespace serialization
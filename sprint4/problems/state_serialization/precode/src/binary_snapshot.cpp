@@ -0,0 +1,380 @@
+#include "binary_snapshot.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <fstream>
+#include <istream>
+#include <numeric>
+#include <ostream>
+#include <stdexcept>
+#include <system_error>
+
+#include "binary_io.h"
+
+namespace serialization {
+using namespace std::literals;
+
+namespace {
+
+constexpr char SNAPSHOT_MAGIC[4] = {'G', 'S', 'N', 'P'};
+constexpr char DELTA_MAGIC[4] = {'G', 'D', 'L', 'T'};
+
+void WriteSession(BinaryWriter& writer, const SessionSnapshot& session) {
+    writer.WriteString(session.map_id);
+    writer.WriteValue<uint64_t>(session.tick);
+
+    writer.WriteValue<uint64_t>(session.dog_ids.size());
+    writer.WriteValue<uint64_t>(session.dog_names.size());
+    writer.WriteValue<uint64_t>(session.bag_item_ids.size());
+    writer.WriteArray(session.dog_ids);
+    writer.WriteArray(session.dog_x);
+    writer.WriteArray(session.dog_y);
+    writer.WriteArray(session.dog_speed_x);
+    writer.WriteArray(session.dog_speed_y);
+    writer.WriteArray(session.dog_directions);
+    writer.WriteArray(session.dog_scores);
+    writer.WriteArray(session.dog_bag_capacities);
+    writer.WriteArray(session.dog_name_lengths);
+    writer.WriteArray(session.dog_names);
+    writer.WriteArray(session.dog_bag_sizes);
+    writer.WriteArray(session.bag_item_ids);
+    writer.WriteArray(session.bag_item_types);
+
+    writer.WriteValue<uint64_t>(session.lost_object_ids.size());
+    writer.WriteArray(session.lost_object_ids);
+    writer.WriteArray(session.lost_object_types);
+    writer.WriteArray(session.lost_object_x);
+    writer.WriteArray(session.lost_object_y);
+}
+
+template <typename Container>
+uint64_t Sum(const Container& values) {
+    return std::accumulate(values.begin(), values.end(), uint64_t{0});
+}
+
+SessionSnapshot ReadSession(BinaryReader& reader) {
+    SessionSnapshot session;
+    session.map_id = reader.ReadString();
+    session.tick = reader.ReadValue<uint64_t>();
+
+    const auto dog_count = reader.ReadValue<uint64_t>();
+    const auto names_size = reader.ReadValue<uint64_t>();
+    const auto bag_items_count = reader.ReadValue<uint64_t>();
+    reader.ReadArray(session.dog_ids, dog_count);
+    reader.ReadArray(session.dog_x, dog_count);
+    reader.ReadArray(session.dog_y, dog_count);
+    reader.ReadArray(session.dog_speed_x, dog_count);
+    reader.ReadArray(session.dog_speed_y, dog_count);
+    reader.ReadArray(session.dog_directions, dog_count);
+    reader.ReadArray(session.dog_scores, dog_count);
+    reader.ReadArray(session.dog_bag_capacities, dog_count);
+    reader.ReadArray(session.dog_name_lengths, dog_count);
+    reader.ReadArray(session.dog_names, names_size);
+    reader.ReadArray(session.dog_bag_sizes, dog_count);
+    reader.ReadArray(session.bag_item_ids, bag_items_count);
+    reader.ReadArray(session.bag_item_types, bag_items_count);
+
+    const auto lost_object_count = reader.ReadValue<uint64_t>();
+    reader.ReadArray(session.lost_object_ids, lost_object_count);
+    reader.ReadArray(session.lost_object_types, lost_object_count);
+    reader.ReadArray(session.lost_object_x, lost_object_count);
+    reader.ReadArray(session.lost_object_y, lost_object_count);
+    return session;
+}
+
+// Все массивы собак и трофеев одной длины, имена и рюкзаки занимают ровно свои массивы
+bool IsConsistent(const SessionSnapshot& s) {
+    const size_t dogs = s.dog_ids.size();
+    const size_t lost_objects = s.lost_object_ids.size();
+    return s.dog_x.size() == dogs && s.dog_y.size() == dogs && s.dog_speed_x.size() == dogs
+        && s.dog_speed_y.size() == dogs && s.dog_directions.size() == dogs
+        && s.dog_scores.size() == dogs && s.dog_bag_capacities.size() == dogs
+        && s.dog_name_lengths.size() == dogs && s.dog_bag_sizes.size() == dogs
+        && Sum(s.dog_name_lengths) == s.dog_names.size()
+        && Sum(s.dog_bag_sizes) == s.bag_item_ids.size()
+        && s.bag_item_types.size() == s.bag_item_ids.size()
+        && s.lost_object_types.size() == lost_objects && s.lost_object_x.size() == lost_objects
+        && s.lost_object_y.size() == lost_objects;
+}
+
+void AppendDog(SessionSnapshot& snapshot, const model::Dog& dog) {
+    snapshot.dog_ids.push_back(*dog.GetId());
+    snapshot.dog_x.push_back(dog.GetPosition().x);
+    snapshot.dog_y.push_back(dog.GetPosition().y);
+    snapshot.dog_speed_x.push_back(dog.GetSpeed().x);
+    snapshot.dog_speed_y.push_back(dog.GetSpeed().y);
+    snapshot.dog_directions.push_back(static_cast<uint8_t>(dog.GetDirection()));
+    snapshot.dog_scores.push_back(dog.GetScore());
+    snapshot.dog_bag_capacities.push_back(dog.GetBagCapacity());
+    const std::string name = dog.GetName();
+    snapshot.dog_name_lengths.push_back(static_cast<uint32_t>(name.size()));
+    snapshot.dog_names += name;
+    snapshot.dog_bag_sizes.push_back(static_cast<uint32_t>(dog.GetBagContent().size()));
+    for (const model::FoundObject& item : dog.GetBagContent()) {
+        snapshot.bag_item_ids.push_back(*item.id);
+        snapshot.bag_item_types.push_back(item.type);
+    }
+}
+
+void AppendLostObject(SessionSnapshot& snapshot, const model::LostObject& obj) {
+    snapshot.lost_object_ids.push_back(*obj.id);
+    snapshot.lost_object_types.push_back(obj.type);
+    snapshot.lost_object_x.push_back(obj.position.x);
+    snapshot.lost_object_y.push_back(obj.position.y);
+}
+
+// Вызывает fn(Dog) для каждой собаки согласованного снимка
+template <typename Fn>
+void ForEachDog(const SessionSnapshot& snapshot, Fn&& fn) {
+    size_t name_offset = 0;
+    size_t bag_offset = 0;
+    for (size_t i = 0; i < snapshot.dog_ids.size(); ++i) {
+        if (snapshot.dog_directions[i] > static_cast<uint8_t>(model::Direction::SOUTH)) {
+            throw std::runtime_error("Invalid direction of dog "s + std::to_string(snapshot.dog_ids[i]));
+        }
+        model::Dog dog{model::Dog::Id{snapshot.dog_ids[i]},
+                       snapshot.dog_names.substr(name_offset, snapshot.dog_name_lengths[i]),
+                       {snapshot.dog_x[i], snapshot.dog_y[i]},
+                       static_cast<size_t>(snapshot.dog_bag_capacities[i])};
+        name_offset += snapshot.dog_name_lengths[i];
+        dog.SetSpeed({snapshot.dog_speed_x[i], snapshot.dog_speed_y[i]});
+        dog.SetDirection(static_cast<model::Direction>(snapshot.dog_directions[i]));
+        dog.AddScore(snapshot.dog_scores[i]);
+        for (uint32_t item = 0; item < snapshot.dog_bag_sizes[i]; ++item, ++bag_offset) {
+            if (!dog.PutToBag({model::FoundObject::Id{snapshot.bag_item_ids[bag_offset]},
+                               snapshot.bag_item_types[bag_offset]})) {
+                throw std::runtime_error("Failed to put bag content");
+            }
+        }
+        fn(std::move(dog));
+    }
+}
+
+template <typename Fn>
+void ForEachLostObject(const SessionSnapshot& snapshot, Fn&& fn) {
+    for (size_t i = 0; i < snapshot.lost_object_ids.size(); ++i) {
+        fn(model::LostObject{model::LostObject::Id{snapshot.lost_object_ids[i]},
+                             snapshot.lost_object_types[i],
+                             {snapshot.lost_object_x[i], snapshot.lost_object_y[i]}});
+    }
+}
+
+// Проверяет сигнатуру magic и версию формата в начале данных
+void CheckHeader(BinaryReader& reader, const char (&magic)[4], uint32_t version, std::string_view what) {
+    std::string actual_magic;
+    reader.ReadArray(actual_magic, sizeof(magic));
+    if (actual_magic != std::string_view{magic, sizeof(magic)}) {
+        throw std::runtime_error("Not a "s + std::string{what});
+    }
+    if (const auto actual_version = reader.ReadValue<uint32_t>(); actual_version != version) {
+        throw std::runtime_error("Unsupported "s + std::string{what} + " version "s
+                                 + std::to_string(actual_version));
+    }
+}
+
+// Дожидается, пока содержимое файла или каталога будет сохранено на диск
+void SyncToDisk(const std::filesystem::path& path, int open_flags) {
+    const int fd = ::open(path.c_str(), open_flags | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::system_error(errno, std::generic_category(), "Failed to open "s + path.string());
+    }
+    const int result = ::fsync(fd);
+    const int error = errno;
+    ::close(fd);
+    if (result != 0) {
+        throw std::system_error(error, std::generic_category(), "Failed to sync "s + path.string());
+    }
+}
+
+}  // namespace
+
+SessionSnapshot CaptureSession(const model::GameSession& session) {
+    const auto& dogs = session.GetDogs();
+    const auto& lost_objects = session.GetLostObjects();
+
+    SessionSnapshot snapshot;
+    snapshot.map_id = *session.GetMapId();
+    snapshot.tick = session.GetTick();
+
+    snapshot.dog_ids.reserve(dogs.size());
+    snapshot.dog_x.reserve(dogs.size());
+    snapshot.dog_y.reserve(dogs.size());
+    snapshot.dog_speed_x.reserve(dogs.size());
+    snapshot.dog_speed_y.reserve(dogs.size());
+    snapshot.dog_directions.reserve(dogs.size());
+    snapshot.dog_scores.reserve(dogs.size());
+    snapshot.dog_bag_capacities.reserve(dogs.size());
+    snapshot.dog_name_lengths.reserve(dogs.size());
+    snapshot.dog_bag_sizes.reserve(dogs.size());
+    for (const model::Dog& dog : dogs) {
+        AppendDog(snapshot, dog);
+    }
+
+    snapshot.lost_object_ids.reserve(lost_objects.size());
+    snapshot.lost_object_types.reserve(lost_objects.size());
+    snapshot.lost_object_x.reserve(lost_objects.size());
+    snapshot.lost_object_y.reserve(lost_objects.size());
+    for (const model::LostObject& obj : lost_objects) {
+        AppendLostObject(snapshot, obj);
+    }
+    return snapshot;
+}
+
+model::GameSession RestoreSession(const SessionSnapshot& snapshot, size_t history_depth) {
+    if (!IsConsistent(snapshot)) {
+        throw std::runtime_error("Inconsistent snapshot of map "s + snapshot.map_id);
+    }
+    model::GameSession session{model::GameSession::MapId{snapshot.map_id}, history_depth};
+    try {
+        ForEachDog(snapshot, [&session](model::Dog dog) {
+            session.AddDog(std::move(dog));
+        });
+        ForEachLostObject(snapshot, [&session](const model::LostObject& obj) {
+            session.AddLostObject(obj);
+        });
+    } catch (const std::invalid_argument& e) {
+        // Повторяющиеся идентификаторы - тоже противоречие в снимке
+        throw std::runtime_error("Inconsistent snapshot of map "s + snapshot.map_id + ": "s + e.what());
+    }
+    session.ResetTick(snapshot.tick);
+    return session;
+}
+
+SessionDelta TakeSessionDelta(model::GameSession& session) {
+    const auto changes = session.TakeUnsavedChanges();
+
+    SessionDelta delta;
+    delta.changed.map_id = *session.GetMapId();
+    delta.changed.tick = session.GetTick();
+    for (const model::Dog::Id& id : changes.dogs) {
+        if (const model::Dog* dog = session.FindDog(id)) {
+            AppendDog(delta.changed, *dog);
+        } else {
+            delta.removed_dog_ids.push_back(*id);
+        }
+    }
+    for (const model::LostObject::Id& id : changes.lost_objects) {
+        if (const model::LostObject* obj = session.FindLostObject(id)) {
+            AppendLostObject(delta.changed, *obj);
+        } else {
+            delta.removed_lost_object_ids.push_back(*id);
+        }
+    }
+    return delta;
+}
+
+void ApplySessionDelta(model::GameSession& session, const SessionDelta& delta) {
+    if (delta.changed.map_id != *session.GetMapId()) {
+        throw std::invalid_argument("Delta of map "s + delta.changed.map_id + " is applied to another map"s);
+    }
+    if (!IsConsistent(delta.changed)) {
+        throw std::runtime_error("Inconsistent delta of map "s + delta.changed.map_id);
+    }
+
+    // Удалённого объекта может не быть: он мог появиться и исчезнуть после прошлого сохранения
+    for (uint32_t id : delta.removed_dog_ids) {
+        session.RemoveDog(model::Dog::Id{id});
+    }
+    for (uint32_t id : delta.removed_lost_object_ids) {
+        session.RemoveLostObject(model::LostObject::Id{id});
+    }
+    ForEachDog(delta.changed, [&session](model::Dog dog) {
+        const model::Dog::Id id = dog.GetId();
+        if (!session.UpdateDog(id, [&dog](model::Dog& existing) {
+                existing = std::move(dog);
+            })) {
+            session.AddDog(std::move(dog));
+        }
+    });
+    ForEachLostObject(delta.changed, [&session](const model::LostObject& obj) {
+        session.RemoveLostObject(obj.id);
+        session.AddLostObject(obj);
+    });
+    session.ResetTick(delta.changed.tick);
+}
+
+void WriteSnapshot(std::ostream& out, std::span<const SessionSnapshot> sessions) {
+    BinaryWriter writer{out};
+    writer.WriteArray(SNAPSHOT_MAGIC);
+    writer.WriteValue(SNAPSHOT_FORMAT_VERSION);
+    writer.WriteValue<uint64_t>(sessions.size());
+    for (const SessionSnapshot& session : sessions) {
+        WriteSession(writer, session);
+    }
+}
+
+std::vector<SessionSnapshot> ReadSnapshot(std::istream& in) {
+    BinaryReader reader{in};
+    CheckHeader(reader, SNAPSHOT_MAGIC, SNAPSHOT_FORMAT_VERSION, "game state snapshot"sv);
+
+    const auto session_count = reader.ReadValue<uint64_t>();
+    std::vector<SessionSnapshot> sessions;
+    for (uint64_t i = 0; i < session_count; ++i) {
+        sessions.push_back(ReadSession(reader));
+    }
+    return sessions;
+}
+
+void WriteDeltas(std::ostream& out, std::span<const SessionDelta> deltas) {
+    BinaryWriter writer{out};
+    writer.WriteArray(DELTA_MAGIC);
+    writer.WriteValue(DELTA_FORMAT_VERSION);
+    writer.WriteValue<uint64_t>(deltas.size());
+    for (const SessionDelta& delta : deltas) {
+        WriteSession(writer, delta.changed);
+        writer.WriteValue<uint64_t>(delta.removed_dog_ids.size());
+        writer.WriteArray(delta.removed_dog_ids);
+        writer.WriteValue<uint64_t>(delta.removed_lost_object_ids.size());
+        writer.WriteArray(delta.removed_lost_object_ids);
+    }
+}
+
+std::vector<SessionDelta> ReadDeltas(std::istream& in) {
+    BinaryReader reader{in};
+    CheckHeader(reader, DELTA_MAGIC, DELTA_FORMAT_VERSION, "game state delta"sv);
+
+    const auto delta_count = reader.ReadValue<uint64_t>();
+    std::vector<SessionDelta> deltas;
+    for (uint64_t i = 0; i < delta_count; ++i) {
+        SessionDelta& delta = deltas.emplace_back();
+        delta.changed = ReadSession(reader);
+        reader.ReadArray(delta.removed_dog_ids, reader.ReadValue<uint64_t>());
+        reader.ReadArray(delta.removed_lost_object_ids, reader.ReadValue<uint64_t>());
+    }
+    return deltas;
+}
+
+void SaveSnapshotFile(const std::filesystem::path& path, std::span<const SessionSnapshot> sessions) {
+    std::filesystem::path temp_path = path;
+    temp_path += ".tmp"s;
+    {
+        std::ofstream out{temp_path, std::ios::binary | std::ios::trunc};
+        if (!out) {
+            throw std::runtime_error("Failed to open "s + temp_path.string());
+        }
+        WriteSnapshot(out, sessions);
+        out.close();
+        if (!out) {
+            throw std::runtime_error("Failed to write "s + temp_path.string());
+        }
+    }
+    // Без синхронизации после сбоя питания под именем path мог бы оказаться пустой
+    // или недописанный файл: переименование попадает на диск раньше данных
+    SyncToDisk(temp_path, O_RDONLY);
+    std::filesystem::rename(temp_path, path);
+    // Запись каталога о переименовании тоже сохраняется на диск явно
+    const auto directory = path.has_parent_path() ? path.parent_path() : std::filesystem::path{"."};
+    SyncToDisk(directory, O_RDONLY | O_DIRECTORY);
+}
+
+std::vector<SessionSnapshot> LoadSnapshotFile(const std::filesystem::path& path) {
+    std::ifstream in{path, std::ios::binary};
+    if (!in) {
+        throw std::runtime_error("Failed to open "s + path.string());
+    }
+    return ReadSnapshot(in);
+}
+
+}  // namespace serialization
@@ -0,0 +1,110 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "game_session.h"
+
+namespace serialization {
+
+/*
+ * Состояние игрового сеанса, разложенное по массивам (структура массивов).
+ * i-я собака - это i-е элементы массивов dog_*, её имя занимает dog_name_lengths[i] байт
+ * в dog_names, а содержимое рюкзака - dog_bag_sizes[i] элементов в bag_item_*.
+ * Снимок не ссылается на сеанс, поэтому его можно записывать в другом потоке.
+ */
+struct SessionSnapshot {
+    std::string map_id;
+    model::Tick tick = 0;
+
+    std::vector<uint32_t> dog_ids;
+    std::vector<double> dog_x;
+    std::vector<double> dog_y;
+    std::vector<double> dog_speed_x;
+    std::vector<double> dog_speed_y;
+    std::vector<uint8_t> dog_directions;
+    std::vector<uint32_t> dog_scores;
+    std::vector<uint64_t> dog_bag_capacities;
+    std::vector<uint32_t> dog_name_lengths;
+    std::string dog_names;
+    std::vector<uint32_t> dog_bag_sizes;
+    std::vector<uint32_t> bag_item_ids;
+    std::vector<uint32_t> bag_item_types;
+
+    std::vector<uint32_t> lost_object_ids;
+    std::vector<uint32_t> lost_object_types;
+    std::vector<double> lost_object_x;
+    std::vector<double> lost_object_y;
+
+    [[nodiscard]] bool operator==(const SessionSnapshot&) const = default;
+};
+
+SessionSnapshot CaptureSession(const model::GameSession& session);
+
+// Выбрасывает std::runtime_error, если снимок противоречив,
+// в том числе если в нём повторяются идентификаторы собак или потерянных предметов
+model::GameSession RestoreSession(const SessionSnapshot& snapshot,
+                                  size_t history_depth = model::GameSession::DEFAULT_HISTORY_DEPTH);
+
+/*
+ * Изменения сеанса с прошлого сохранения: в changed - текущее состояние изменённых
+ * и добавленных собак и трофеев, а также тик, по который учтены изменения
+ */
+struct SessionDelta {
+    SessionSnapshot changed;
+    std::vector<uint32_t> removed_dog_ids;
+    std::vector<uint32_t> removed_lost_object_ids;
+
+    bool HasChanges() const noexcept {
+        return !changed.dog_ids.empty() || !changed.lost_object_ids.empty() || !removed_dog_ids.empty()
+            || !removed_lost_object_ids.empty();
+    }
+
+    [[nodiscard]] bool operator==(const SessionDelta&) const = default;
+};
+
+// Собирает изменения сеанса с прошлого вызова (см. GameSession::TakeUnsavedChanges)
+SessionDelta TakeSessionDelta(model::GameSession& session);
+
+/*
+ * Применяет изменения к сеансу, восстановленному из предыдущего сохранения,
+ * и устанавливает тик сеанса равным тику изменений.
+ * Выбрасывает std::invalid_argument, если изменения относятся к другой карте,
+ * и std::runtime_error, если они противоречивы
+ */
+void ApplySessionDelta(model::GameSession& session, const SessionDelta& delta);
+
+/*
+ * Двоичный формат снимка состояния игры:
+ *   "GSNP", версия формата (uint32), количество сеансов (uint64), затем сеансы.
+ * Все числа записываются в порядке little-endian. Каждый массив SessionSnapshot
+ * пишется и читается одной операцией, без разбора текста.
+ */
+inline constexpr uint32_t SNAPSHOT_FORMAT_VERSION = 1;
+
+void WriteSnapshot(std::ostream& out, std::span<const SessionSnapshot> sessions);
+
+// Выбрасывает std::runtime_error, если данные повреждены, обрезаны или другой версии
+std::vector<SessionSnapshot> ReadSnapshot(std::istream& in);
+
+/*
+ * Двоичный формат изменений: "GDLT", версия формата (uint32), количество сеансов (uint64),
+ * затем для каждого сеанса changed в формате снимка и массивы удалённых объектов
+ */
+inline constexpr uint32_t DELTA_FORMAT_VERSION = 1;
+
+void WriteDeltas(std::ostream& out, std::span<const SessionDelta> deltas);
+
+// Выбрасывает std::runtime_error, если данные повреждены, обрезаны или другой версии
+std::vector<SessionDelta> ReadDeltas(std::istream& in);
+
+// Записывает снимок во временный файл, сохраняет его на диск (fsync) и переименовывает в path,
+// после чего синхронизирует каталог. Даже после сбоя питания в path лежит
+// либо старый, либо новый снимок целиком
+void SaveSnapshotFile(const std::filesystem::path& path, std::span<const SessionSnapshot> sessions);
+std::vector<SessionSnapshot> LoadSnapshotFile(const std::filesystem::path& path);
+
+}  // namespace serialization
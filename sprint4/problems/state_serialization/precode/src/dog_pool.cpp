@@ -0,0 +1,70 @@
+#include "dog_pool.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace model {
+
+namespace {
+
+// Обеспечивает место для ещё одного элемента, сохраняя геометрический рост ёмкости
+template <typename T>
+void ReserveOneMore(std::vector<T>& values) {
+    if (values.size() == values.capacity()) {
+        values.reserve(std::max<size_t>(values.capacity() * 2, 8));
+    }
+}
+
+}  // namespace
+
+DogHandle DogPool::Add(Dog dog) {
+    if (dogs_.size() >= FREE) {
+        throw std::length_error("Too many dogs in pool");
+    }
+
+    // Резервируем память заранее: после добавления собаки ничто не должно выбросить исключение
+    ReserveOneMore(dense_to_slot_);
+    if (free_slots_.empty()) {
+        ReserveOneMore(slots_);
+    }
+    dogs_.emplace_back(std::move(dog));
+
+    uint32_t index;
+    if (free_slots_.empty()) {
+        index = static_cast<uint32_t>(slots_.size());
+        slots_.emplace_back();
+    } else {
+        index = free_slots_.back();
+        free_slots_.pop_back();
+    }
+    dense_to_slot_.push_back(index);
+
+    Slot& slot = slots_[index];
+    slot.dense_index = static_cast<uint32_t>(dogs_.size() - 1);
+    return {index, slot.generation};
+}
+
+bool DogPool::Remove(DogHandle handle) {
+    if (!IsValid(handle)) {
+        return false;
+    }
+
+    Slot& slot = slots_[handle.index];
+    const uint32_t dense_index = slot.dense_index;
+    const uint32_t last = static_cast<uint32_t>(dogs_.size() - 1);
+    if (dense_index != last) {
+        // Последняя собака занимает место удалённой, чтобы вектор оставался плотным
+        dogs_[dense_index] = std::move(dogs_[last]);
+        dense_to_slot_[dense_index] = dense_to_slot_[last];
+        slots_[dense_to_slot_[dense_index]].dense_index = dense_index;
+    }
+    dogs_.pop_back();
+    dense_to_slot_.pop_back();
+
+    slot.dense_index = FREE;
+    ++slot.generation;
+    free_slots_.push_back(handle.index);
+    return true;
+}
+
+}  // namespace model
@@ -0,0 +1,78 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "model.h"
+
+namespace model {
+
+// Дескриптор объекта типа T в пуле: индекс ячейки и её поколение.
+// После удаления объекта поколение ячейки меняется, и старый дескриптор становится недействительным
+template <typename T>
+struct PoolHandle {
+    uint32_t index = 0;
+    uint32_t generation = 0;
+
+    [[nodiscard]] auto operator<=>(const PoolHandle&) const = default;
+};
+
+using DogHandle = PoolHandle<Dog>;
+
+/*
+ * Пул собак игрового сеанса.
+ * Собаки лежат в одном плотном векторе, поэтому обход всех собак идёт по
+ * непрерывной памяти, а освобождённые ячейки переиспользуются без обращения к аллокатору.
+ * Дескрипторы остаются действительными при удалении других собак.
+ */
+class DogPool {
+public:
+    using Dogs = std::vector<Dog>;
+
+    DogHandle Add(Dog dog);
+
+    // Возвращает false, если дескриптор устарел
+    bool Remove(DogHandle handle);
+
+    bool IsValid(DogHandle handle) const noexcept {
+        return handle.index < slots_.size() && slots_[handle.index].generation == handle.generation
+            && slots_[handle.index].dense_index != FREE;
+    }
+
+    // Возвращает nullptr для устаревшего дескриптора
+    Dog* Get(DogHandle handle) noexcept {
+        return IsValid(handle) ? &dogs_[slots_[handle.index].dense_index] : nullptr;
+    }
+
+    const Dog* Get(DogHandle handle) const noexcept {
+        return IsValid(handle) ? &dogs_[slots_[handle.index].dense_index] : nullptr;
+    }
+
+    // Дескриптор собаки с позицией position в GetDogs()
+    DogHandle GetHandle(size_t position) const noexcept {
+        const uint32_t index = dense_to_slot_[position];
+        return {index, slots_[index].generation};
+    }
+
+    const Dogs& GetDogs() const noexcept {
+        return dogs_;
+    }
+
+    size_t GetSize() const noexcept {
+        return dogs_.size();
+    }
+
+private:
+    static constexpr uint32_t FREE = UINT32_MAX;
+
+    struct Slot {
+        uint32_t generation = 0;
+        uint32_t dense_index = FREE;
+    };
+
+    Dogs dogs_;
+    std::vector<uint32_t> dense_to_slot_;
+    std::vector<Slot> slots_;
+    std::vector<uint32_t> free_slots_;
+};
+
+}  // namespace model
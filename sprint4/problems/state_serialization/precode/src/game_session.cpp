@@ -0,0 +1,153 @@
+#include "game_session.h"
+
+#include <stdexcept>
+
+namespace model {
+using namespace std::literals;
+
+namespace {
+
+// Удаляет элемент, найденный по словарю, перенося последний элемент вектора на его место
+template <typename Objects, typename IdToIndex, typename GetId>
+bool EraseByIndex(Objects& objects, IdToIndex& id_to_index,
+                  const typename IdToIndex::key_type& id, GetId get_id) {
+    auto it = id_to_index.find(id);
+    if (it == id_to_index.end()) {
+        return false;
+    }
+    const size_t index = it->second;
+    id_to_index.erase(it);
+    if (index + 1 != objects.size()) {
+        objects[index] = std::move(objects.back());
+        id_to_index.at(get_id(objects[index])) = index;
+    }
+    objects.pop_back();
+    return true;
+}
+
+}  // namespace
+
+GameSession::GameSession(MapId map_id, size_t history_depth)
+    : map_id_{std::move(map_id)}
+    , changes_{history_depth} {
+}
+
+DogHandle GameSession::AddDog(Dog dog) {
+    const Dog::Id id = dog.GetId();
+    auto [it, inserted] = dog_id_to_handle_.emplace(id, DogHandle{});
+    if (!inserted) {
+        throw std::invalid_argument("Dog with id "s + std::to_string(*id) + " already exists"s);
+    }
+    try {
+        it->second = dogs_.Add(std::move(dog));
+    } catch (...) {
+        dog_id_to_handle_.erase(it);
+        throw;
+    }
+    changes_.TouchDog(id);
+    return it->second;
+}
+
+bool GameSession::RemoveDog(const Dog::Id& id) {
+    auto it = dog_id_to_handle_.find(id);
+    if (it == dog_id_to_handle_.end()) {
+        return false;
+    }
+    dogs_.Remove(it->second);
+    dog_id_to_handle_.erase(it);
+    changes_.TouchDog(id);
+    return true;
+}
+
+const Dog* GameSession::FindDog(const Dog::Id& id) const noexcept {
+    if (auto it = dog_id_to_handle_.find(id); it != dog_id_to_handle_.end()) {
+        return dogs_.Get(it->second);
+    }
+    return nullptr;
+}
+
+std::optional<DogHandle> GameSession::FindDogHandle(const Dog::Id& id) const noexcept {
+    if (auto it = dog_id_to_handle_.find(id); it != dog_id_to_handle_.end()) {
+        return it->second;
+    }
+    return std::nullopt;
+}
+
+void GameSession::AddLostObject(LostObject lost_object) {
+    const size_t index = lost_objects_.size();
+    if (!lost_object_id_to_index_.emplace(lost_object.id, index).second) {
+        throw std::invalid_argument("Lost object with id "s + std::to_string(*lost_object.id)
+                                    + " already exists"s);
+    }
+    try {
+        lost_objects_.push_back(lost_object);
+    } catch (...) {
+        lost_object_id_to_index_.erase(lost_object.id);
+        throw;
+    }
+    changes_.TouchLostObject(lost_object.id);
+}
+
+bool GameSession::RemoveLostObject(const LostObject::Id& id) {
+    if (!EraseByIndex(lost_objects_, lost_object_id_to_index_, id, [](const LostObject& obj) {
+            return obj.id;
+        })) {
+        return false;
+    }
+    changes_.TouchLostObject(id);
+    return true;
+}
+
+const LostObject* GameSession::FindLostObject(const LostObject::Id& id) const noexcept {
+    if (auto it = lost_object_id_to_index_.find(id); it != lost_object_id_to_index_.end()) {
+        return &lost_objects_[it->second];
+    }
+    return nullptr;
+}
+
+Tick GameSession::CommitTick() {
+    return changes_.CommitTick();
+}
+
+GameSession::StateUpdate GameSession::GetStateSince(Tick since) const {
+    const auto changed = changes_.GetChangesSince(since);
+    if (!changed) {
+        return GetFullState();
+    }
+
+    // Изменённый объект, которого уже нет в сеансе, был удалён
+    StateUpdate update;
+    update.tick = GetTick();
+    for (const auto& id : changed->dogs) {
+        if (const Dog* dog = FindDog(id)) {
+            update.dogs.push_back(dog);
+        } else {
+            update.removed_dogs.push_back(id);
+        }
+    }
+    for (const auto& id : changed->lost_objects) {
+        if (const LostObject* obj = FindLostObject(id)) {
+            update.lost_objects.push_back(obj);
+        } else {
+            update.removed_lost_objects.push_back(id);
+        }
+    }
+    return update;
+}
+
+GameSession::StateUpdate GameSession::GetFullState() const {
+    StateUpdate update;
+    update.tick = GetTick();
+    update.is_full = true;
+    update.dogs.reserve(dogs_.GetSize());
+    for (const Dog& dog : dogs_.GetDogs()) {
+        update.dogs.push_back(&dog);
+    }
+    update.lost_objects.reserve(lost_objects_.size());
+    for (const LostObject& obj : lost_objects_) {
+        update.lost_objects.push_back(&obj);
+    }
+    return update;
+}
+
+}  // namespace model
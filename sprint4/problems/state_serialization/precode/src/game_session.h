@@ -0,0 +1,119 @@
+#pragma once
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "dog_pool.h"
+#include "model.h"
+#include "state_change_log.h"
+
+namespace model {
+
+/*
+ * Игровой сеанс на одной карте: собаки и трофеи.
+ * Все изменения объектов проходят через методы сеанса, поэтому сеанс может
+ * отдавать клиентам только то, что изменилось с известного им тика.
+ */
+class GameSession {
+public:
+    using MapId = util::Tagged<std::string, GameSession>;
+    using Dogs = DogPool::Dogs;
+    using LostObjects = std::vector<LostObject>;
+
+    // Сколько последних тиков хранится для построения разностных обновлений
+    static constexpr size_t DEFAULT_HISTORY_DEPTH = 64;
+
+    // Обновление состояния для клиента, знающего состояние на тике since.
+    // Указатели действительны до следующего изменения сеанса
+    struct StateUpdate {
+        Tick tick = 0;
+        // true - в dogs и lost_objects перечислены все объекты сеанса
+        bool is_full = false;
+        std::vector<const Dog*> dogs;
+        std::vector<const LostObject*> lost_objects;
+        std::vector<Dog::Id> removed_dogs;
+        std::vector<LostObject::Id> removed_lost_objects;
+    };
+
+    explicit GameSession(MapId map_id, size_t history_depth = DEFAULT_HISTORY_DEPTH);
+
+    const MapId& GetMapId() const noexcept {
+        return map_id_;
+    }
+
+    const Dogs& GetDogs() const noexcept {
+        return dogs_.GetDogs();
+    }
+
+    const LostObjects& GetLostObjects() const noexcept {
+        return lost_objects_;
+    }
+
+    Tick GetTick() const noexcept {
+        return changes_.GetTick();
+    }
+
+    DogHandle AddDog(Dog dog);
+    bool RemoveDog(const Dog::Id& id);
+    const Dog* FindDog(const Dog::Id& id) const noexcept;
+    std::optional<DogHandle> FindDogHandle(const Dog::Id& id) const noexcept;
+
+    // Возвращает nullptr, если собака покинула сеанс
+    const Dog* GetDog(DogHandle handle) const noexcept {
+        return dogs_.Get(handle);
+    }
+
+    // Изменяет собаку функцией fn(Dog&) и отмечает её изменённой в текущем тике
+    template <typename Fn>
+    bool UpdateDog(DogHandle handle, Fn&& fn) {
+        if (Dog* dog = dogs_.Get(handle)) {
+            fn(*dog);
+            changes_.TouchDog(dog->GetId());
+            return true;
+        }
+        return false;
+    }
+
+    template <typename Fn>
+    bool UpdateDog(const Dog::Id& id, Fn&& fn) {
+        const auto handle = FindDogHandle(id);
+        return handle && UpdateDog(*handle, std::forward<Fn>(fn));
+    }
+
+    void AddLostObject(LostObject lost_object);
+    bool RemoveLostObject(const LostObject::Id& id);
+    const LostObject* FindLostObject(const LostObject::Id& id) const noexcept;
+
+    // Завершает тик, фиксируя накопленные изменения
+    Tick CommitTick();
+
+    // Устанавливает номер тика восстановленного сеанса и забывает историю изменений
+    void ResetTick(Tick tick) {
+        changes_.Reset(tick);
+    }
+
+    // Собаки и трофеи, изменённые, добавленные или удалённые в завершённых тиках
+    // с прошлого вызова. Используется для сохранения только изменившихся объектов
+    StateChangeLog::ChangedIds TakeUnsavedChanges() {
+        return changes_.TakeUnsavedChanges();
+    }
+
+    // Возвращает изменения с тика since либо полный снимок, если клиент слишком отстал
+    StateUpdate GetStateSince(Tick since) const;
+    StateUpdate GetFullState() const;
+
+private:
+    using DogIdToHandle = std::unordered_map<Dog::Id, DogHandle, util::TaggedHasher<Dog::Id>>;
+    using LostObjectIdToIndex
+        = std::unordered_map<LostObject::Id, size_t, util::TaggedHasher<LostObject::Id>>;
+
+    MapId map_id_;
+    DogPool dogs_;
+    DogIdToHandle dog_id_to_handle_;
+    LostObjects lost_objects_;
+    LostObjectIdToIndex lost_object_id_to_index_;
+    StateChangeLog changes_;
+};
+
+}  // namespace model
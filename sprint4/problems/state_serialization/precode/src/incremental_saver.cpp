@@ -0,0 +1,120 @@
+#include "incremental_saver.h"
+
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+#include "record_file.h"
+
+namespace serialization {
+
+namespace {
+
+std::vector<SessionDelta> ReadDeltaFile(const std::filesystem::path& path) {
+    std::vector<SessionDelta> deltas;
+    // Запись могла не дописаться из-за сбоя посреди сохранения
+    ForEachRecordData(ReadWholeFile(path), [&deltas](const std::string& data) {
+        std::istringstream in{data};
+        auto record = ReadDeltas(in);
+        deltas.insert(deltas.end(), std::make_move_iterator(record.begin()),
+                      std::make_move_iterator(record.end()));
+    });
+    return deltas;
+}
+
+}  // namespace
+
+IncrementalSaver::IncrementalSaver(std::filesystem::path snapshot_path, std::filesystem::path delta_path,
+                                   double compaction_ratio)
+    : snapshot_path_{std::move(snapshot_path)}
+    , delta_file_{std::move(delta_path)}
+    , compaction_ratio_{compaction_ratio} {
+    if (!(compaction_ratio > 0)) {
+        throw std::invalid_argument("Compaction ratio must be positive");
+    }
+}
+
+bool IncrementalSaver::Save(std::span<model::GameSession> sessions) {
+    if (!snapshot_size_) {
+        Compact(sessions);
+        return true;
+    }
+
+    std::vector<SessionDelta> deltas;
+    for (model::GameSession& session : sessions) {
+        if (SessionDelta delta = TakeSessionDelta(session); delta.HasChanges()) {
+            deltas.push_back(std::move(delta));
+        }
+    }
+    if (deltas.empty()) {
+        return false;
+    }
+
+    std::ostringstream out;
+    WriteDeltas(out, deltas);
+    std::string record;
+    AppendRecord(record, std::move(out).str());
+    const uint64_t record_size = record.size();
+    const auto max_delta_size = compaction_ratio_ * static_cast<double>(*snapshot_size_);
+    if (static_cast<double>(delta_size_ + record_size) > max_delta_size) {
+        Compact(sessions);
+        return true;
+    }
+
+    try {
+        delta_file_.Write(record);
+    } catch (...) {
+        // Изменения уже забраны у сеансов, и сохранить их теперь может только полный снимок
+        snapshot_size_.reset();
+        throw;
+    }
+    delta_size_ += record_size;
+    return false;
+}
+
+void IncrementalSaver::Compact(std::span<model::GameSession> sessions) {
+    std::vector<SessionSnapshot> snapshots;
+    snapshots.reserve(sessions.size());
+    for (model::GameSession& session : sessions) {
+        // Всё изменённое попадёт в снимок
+        session.TakeUnsavedChanges();
+        snapshots.push_back(CaptureSession(session));
+    }
+
+    snapshot_size_.reset();
+    SaveSnapshotFile(snapshot_path_, snapshots);
+    // Если сбой случится до очистки, при загрузке изменения будут пропущены: их тики не новее снимка
+    delta_file_.Truncate();
+    snapshot_size_ = std::filesystem::file_size(snapshot_path_);
+    delta_size_ = 0;
+}
+
+std::vector<model::GameSession> LoadIncrementalState(const std::filesystem::path& snapshot_path,
+                                                     const std::filesystem::path& delta_path,
+                                                     size_t history_depth) {
+    std::vector<model::GameSession> sessions;
+    std::unordered_map<std::string, size_t> map_id_to_index;
+    for (const SessionSnapshot& snapshot : LoadSnapshotFile(snapshot_path)) {
+        map_id_to_index.emplace(snapshot.map_id, sessions.size());
+        sessions.push_back(RestoreSession(snapshot, history_depth));
+    }
+    if (!std::filesystem::exists(delta_path)) {
+        return sessions;
+    }
+
+    for (const SessionDelta& delta : ReadDeltaFile(delta_path)) {
+        auto [it, inserted] = map_id_to_index.emplace(delta.changed.map_id, sessions.size());
+        if (inserted) {
+            sessions.emplace_back(model::GameSession::MapId{delta.changed.map_id}, history_depth);
+        }
+        model::GameSession& session = sessions[it->second];
+        if (inserted || delta.changed.tick > session.GetTick()) {
+            ApplySessionDelta(session, delta);
+        }
+    }
+    return sessions;
+}
+
+}  // namespace serialization
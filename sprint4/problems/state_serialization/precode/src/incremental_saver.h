@@ -0,0 +1,59 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "binary_snapshot.h"
+#include "record_file.h"
+
+namespace serialization {
+
+/*
+ * Сохраняет состояние игры в два файла: полный снимок и файл изменений.
+ * Save дописывает в файл изменений лишь собак и трофеи, изменённые с прошлого сохранения,
+ * так что объём записи растёт с активностью игроков, а не с их количеством.
+ * Когда файл изменений становится больше compaction_ratio размеров снимка,
+ * вместо очередных изменений записывается новый полный снимок, а файл изменений очищается.
+ */
+class IncrementalSaver {
+public:
+    // Открывает файл изменений, отрезая недописанный хвост.
+    // Выбрасывает std::invalid_argument, если compaction_ratio не положителен
+    IncrementalSaver(std::filesystem::path snapshot_path, std::filesystem::path delta_path,
+                     double compaction_ratio = 1.0);
+
+    /*
+     * Сохраняет изменения сеансов. Первое сохранение всегда записывает полный снимок.
+     * Возвращает true, если был записан полный снимок.
+     * После ошибки записи следующее сохранение записывает полный снимок
+     */
+    bool Save(std::span<model::GameSession> sessions);
+
+    // Записывает полный снимок и очищает файл изменений
+    void Compact(std::span<model::GameSession> sessions);
+
+    uint64_t GetDeltaSize() const noexcept {
+        return delta_size_;
+    }
+
+private:
+    std::filesystem::path snapshot_path_;
+    RecordFileWriter delta_file_;
+    double compaction_ratio_;
+    // Размер последнего снимка. Пуст, пока снимок не записан этим объектом
+    std::optional<uint64_t> snapshot_size_;
+    uint64_t delta_size_ = 0;
+};
+
+/*
+ * Восстанавливает сеансы из снимка и применяет к ним изменения из файла изменений,
+ * если он есть. Изменения, уже учтённые в снимке, пропускаются, а недописанные
+ * или повреждённые изменения в конце файла отбрасываются
+ */
+std::vector<model::GameSession> LoadIncrementalState(
+    const std::filesystem::path& snapshot_path, const std::filesystem::path& delta_path,
+    size_t history_depth = model::GameSession::DEFAULT_HISTORY_DEPTH);
+
+}  // namespace serialization
@@ -0,0 +1,251 @@
+#include "journal.h"
+
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "binary_io.h"
+#include "record_file.h"
+
+namespace serialization {
+using namespace std::literals;
+
+namespace {
+
+void WriteRecordBody(BinaryWriter& w, const journal::DogJoined& r) {
+    w.WriteValue(*r.dog_id);
+    w.WriteString(r.name);
+    w.WriteValue(r.position.x);
+    w.WriteValue(r.position.y);
+    w.WriteValue(r.bag_capacity);
+}
+
+void WriteRecordBody(BinaryWriter& w, const journal::DogMoved& r) {
+    w.WriteValue(*r.dog_id);
+    w.WriteValue(static_cast<uint8_t>(r.direction));
+    w.WriteValue(r.speed.x);
+    w.WriteValue(r.speed.y);
+}
+
+void WriteRecordBody(BinaryWriter& w, const journal::LootSpawned& r) {
+    w.WriteValue(*r.lost_object.id);
+    w.WriteValue(r.lost_object.type);
+    w.WriteValue(r.lost_object.position.x);
+    w.WriteValue(r.lost_object.position.y);
+}
+
+void WriteRecordBody(BinaryWriter& w, const journal::LootPickedUp& r) {
+    w.WriteValue(*r.dog_id);
+    w.WriteValue(*r.lost_object_id);
+}
+
+void WriteRecordBody(BinaryWriter& w, const journal::DogRetired& r) {
+    w.WriteValue(*r.dog_id);
+}
+
+void WriteRecordBody(BinaryWriter& w, const journal::TickCompleted& r) {
+    w.WriteValue<int64_t>(r.time_delta.count());
+}
+
+void ReadRecordBody(BinaryReader& r, journal::DogJoined& record) {
+    record.dog_id = model::Dog::Id{r.ReadValue<uint32_t>()};
+    record.name = r.ReadString();
+    record.position.x = r.ReadValue<double>();
+    record.position.y = r.ReadValue<double>();
+    record.bag_capacity = r.ReadValue<uint64_t>();
+}
+
+void ReadRecordBody(BinaryReader& r, journal::DogMoved& record) {
+    record.dog_id = model::Dog::Id{r.ReadValue<uint32_t>()};
+    const auto direction = r.ReadValue<uint8_t>();
+    if (direction > static_cast<uint8_t>(model::Direction::SOUTH)) {
+        throw std::runtime_error("Invalid direction in journal");
+    }
+    record.direction = static_cast<model::Direction>(direction);
+    record.speed.x = r.ReadValue<double>();
+    record.speed.y = r.ReadValue<double>();
+}
+
+void ReadRecordBody(BinaryReader& r, journal::LootSpawned& record) {
+    record.lost_object.id = model::LostObject::Id{r.ReadValue<uint32_t>()};
+    record.lost_object.type = r.ReadValue<model::LostObjectType>();
+    record.lost_object.position.x = r.ReadValue<double>();
+    record.lost_object.position.y = r.ReadValue<double>();
+}
+
+void ReadRecordBody(BinaryReader& r, journal::LootPickedUp& record) {
+    record.dog_id = model::Dog::Id{r.ReadValue<uint32_t>()};
+    record.lost_object_id = model::LostObject::Id{r.ReadValue<uint32_t>()};
+}
+
+void ReadRecordBody(BinaryReader& r, journal::DogRetired& record) {
+    record.dog_id = model::Dog::Id{r.ReadValue<uint32_t>()};
+}
+
+void ReadRecordBody(BinaryReader& r, journal::TickCompleted& record) {
+    record.time_delta = std::chrono::milliseconds{r.ReadValue<int64_t>()};
+}
+
+// Данные записи: номер альтернативы JournalRecord, сеанс, тик и поля записи
+std::string SerializeRecord(const JournalRecord& record) {
+    std::ostringstream out;
+    BinaryWriter writer{out};
+    writer.WriteValue(static_cast<uint8_t>(record.index()));
+    std::visit(
+        [&writer](const auto& r) {
+            writer.WriteString(r.map_id);
+            writer.WriteValue<uint64_t>(r.tick);
+            WriteRecordBody(writer, r);
+        },
+        record);
+    return std::move(out).str();
+}
+
+template <size_t Index = 0>
+JournalRecord MakeRecord(size_t index) {
+    if constexpr (Index < std::variant_size_v<JournalRecord>) {
+        return index == Index ? JournalRecord{std::in_place_index<Index>} : MakeRecord<Index + 1>(index);
+    } else {
+        throw std::runtime_error("Unknown journal record type "s + std::to_string(index));
+    }
+}
+
+JournalRecord DeserializeRecord(const std::string& data) {
+    std::istringstream in{data};
+    BinaryReader reader{in};
+    JournalRecord record = MakeRecord(reader.ReadValue<uint8_t>());
+    std::visit(
+        [&reader](auto& r) {
+            r.map_id = reader.ReadString();
+            r.tick = reader.ReadValue<uint64_t>();
+            ReadRecordBody(reader, r);
+        },
+        record);
+    if (!reader.AtEnd()) {
+        throw std::runtime_error("Unexpected data in journal record");
+    }
+    return record;
+}
+
+// Применяет запись к сеансу, тик которого предшествует тику записи
+class RecordApplier {
+public:
+    RecordApplier(model::GameSession& session, const TickReplayHandler& on_tick)
+        : session_{session}
+        , on_tick_{on_tick} {
+    }
+
+    void operator()(const journal::DogJoined& r) const {
+        session_.AddDog(model::Dog{r.dog_id, r.name, r.position, static_cast<size_t>(r.bag_capacity)});
+    }
+
+    void operator()(const journal::DogMoved& r) const {
+        Check(session_.UpdateDog(r.dog_id, [&r](model::Dog& dog) {
+            dog.SetDirection(r.direction);
+            dog.SetSpeed(r.speed);
+        }));
+    }
+
+    void operator()(const journal::LootSpawned& r) const {
+        session_.AddLostObject(r.lost_object);
+    }
+
+    void operator()(const journal::LootPickedUp& r) const {
+        const model::LostObject* lost_object = session_.FindLostObject(r.lost_object_id);
+        Check(lost_object != nullptr);
+        const model::FoundObject item{model::FoundObject::Id{*lost_object->id}, lost_object->type};
+        bool put = false;
+        Check(session_.UpdateDog(r.dog_id, [&](model::Dog& dog) {
+            put = dog.PutToBag(item);
+        }));
+        Check(put);
+        session_.RemoveLostObject(r.lost_object_id);
+    }
+
+    void operator()(const journal::DogRetired& r) const {
+        Check(session_.RemoveDog(r.dog_id));
+    }
+
+    void operator()(const journal::TickCompleted& r) const {
+        if (on_tick_) {
+            on_tick_(session_, r.time_delta);
+        }
+        session_.CommitTick();
+    }
+
+private:
+    void Check(bool condition) const {
+        if (!condition) {
+            throw std::runtime_error("Journal record does not match state of map "s
+                                     + *session_.GetMapId());
+        }
+    }
+
+    model::GameSession& session_;
+    const TickReplayHandler& on_tick_;
+};
+
+}  // namespace
+
+JournalWriter::JournalWriter(std::filesystem::path path)
+    : file_{std::move(path)} {
+}
+
+void JournalWriter::Append(const JournalRecord& record) {
+    AppendRecord(pending_, SerializeRecord(record));
+}
+
+void JournalWriter::Commit() {
+    // До успешного fdatasync записи остаются в pending_, чтобы их можно было записать заново
+    file_.Write(pending_);
+    pending_.clear();
+}
+
+void JournalWriter::Truncate() {
+    file_.Truncate();
+}
+
+std::vector<JournalRecord> ReadJournal(const std::filesystem::path& path) {
+    std::vector<JournalRecord> records;
+    ForEachRecordData(ReadWholeFile(path), [&records](const std::string& data) {
+        records.push_back(DeserializeRecord(data));
+    });
+    return records;
+}
+
+void ReplayJournal(std::span<const JournalRecord> records, std::vector<model::GameSession>& sessions,
+                   const TickReplayHandler& on_tick) {
+    std::unordered_map<std::string, size_t> map_id_to_index;
+    for (size_t i = 0; i < sessions.size(); ++i) {
+        map_id_to_index.emplace(*sessions[i].GetMapId(), i);
+    }
+
+    for (const JournalRecord& record : records) {
+        const auto& [map_id, tick] = std::visit(
+            [](const auto& r) {
+                return std::pair<const std::string&, model::Tick>{r.map_id, r.tick};
+            },
+            record);
+
+        if (tick == 0) {
+            throw std::runtime_error("Journal record of map "s + map_id + " has no tick"s);
+        }
+        auto [it, inserted] = map_id_to_index.emplace(map_id, sessions.size());
+        if (inserted) {
+            sessions.emplace_back(model::GameSession::MapId{map_id});
+            sessions.back().ResetTick(tick - 1);
+        }
+        model::GameSession& session = sessions[it->second];
+
+        // Записи до снимка уже учтены в нём
+        if (tick <= session.GetTick()) {
+            continue;
+        }
+        if (tick != session.GetTick() + 1) {
+            throw std::runtime_error("Journal of map "s + map_id + " does not continue its snapshot"s);
+        }
+        std::visit(RecordApplier{session, on_tick}, record);
+    }
+}
+
+}  // namespace serialization
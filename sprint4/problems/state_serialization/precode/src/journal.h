@@ -0,0 +1,137 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <span>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "game_session.h"
+#include "record_file.h"
+
+namespace serialization {
+
+/*
+ * Записи журнала действий игроков. Каждая относится к сеансу map_id
+ * и к тику tick, в котором она произошла (тик ещё не завершён)
+ */
+namespace journal {
+
+struct DogJoined {
+    std::string map_id;
+    model::Tick tick = 0;
+    model::Dog::Id dog_id{0u};
+    std::string name;
+    geom::Point2D position;
+    uint64_t bag_capacity = 0;
+
+    [[nodiscard]] bool operator==(const DogJoined&) const = default;
+};
+
+struct DogMoved {
+    std::string map_id;
+    model::Tick tick = 0;
+    model::Dog::Id dog_id{0u};
+    model::Direction direction = model::Direction::NORTH;
+    geom::Vec2D speed;
+
+    [[nodiscard]] bool operator==(const DogMoved&) const = default;
+};
+
+struct LootSpawned {
+    std::string map_id;
+    model::Tick tick = 0;
+    model::LostObject lost_object;
+
+    [[nodiscard]] bool operator==(const LootSpawned&) const = default;
+};
+
+struct LootPickedUp {
+    std::string map_id;
+    model::Tick tick = 0;
+    model::Dog::Id dog_id{0u};
+    model::LostObject::Id lost_object_id{0u};
+
+    [[nodiscard]] bool operator==(const LootPickedUp&) const = default;
+};
+
+struct DogRetired {
+    std::string map_id;
+    model::Tick tick = 0;
+    model::Dog::Id dog_id{0u};
+
+    [[nodiscard]] bool operator==(const DogRetired&) const = default;
+};
+
+// Завершение тика tick, длившегося time_delta
+struct TickCompleted {
+    std::string map_id;
+    model::Tick tick = 0;
+    std::chrono::milliseconds time_delta{0};
+
+    [[nodiscard]] bool operator==(const TickCompleted&) const = default;
+};
+
+}  // namespace journal
+
+using JournalRecord = std::variant<journal::DogJoined, journal::DogMoved, journal::LootSpawned,
+                                   journal::LootPickedUp, journal::DogRetired, journal::TickCompleted>;
+
+/*
+ * Журнал, в который только дописываются записи.
+ * Append лишь копит запись в памяти, а Commit одной операцией записи и одним fsync
+ * сохраняет всё накопленное. Вызывая Commit раз за тик, сервер платит за надёжность
+ * одной синхронизацией с диском за тик, а не за каждый запрос.
+ * Каждая запись снабжена длиной и контрольной суммой.
+ */
+class JournalWriter {
+public:
+    // Открывает журнал для дописывания, создавая файл при необходимости.
+    // Недописанный хвост, оставшийся от сбоя посреди Commit, отрезается,
+    // чтобы новые записи не оказались за ним недоступными для ReadJournal
+    explicit JournalWriter(std::filesystem::path path);
+
+    void Append(const JournalRecord& record);
+
+    /*
+     * Записывает накопленные записи и дожидается их сохранения на диск.
+     * После ошибки накопленные записи сохраняются, а следующий Commit обрезает журнал
+     * до последней синхронизированной записи и записывает их заново.
+     * Ни одна запись не попадает в журнал дважды
+     */
+    void Commit();
+
+    // Очищает журнал. Вызывается, когда сохранён снимок, покрывающий все его записи
+    void Truncate();
+
+    size_t GetPendingSize() const noexcept {
+        return pending_.size();
+    }
+
+private:
+    RecordFileWriter file_;
+    std::string pending_;
+};
+
+/*
+ * Читает записи журнала до конца файла либо до первой недописанной
+ * или повреждённой записи: она могла остаться от сбоя посреди Commit
+ */
+std::vector<JournalRecord> ReadJournal(const std::filesystem::path& path);
+
+// Обработчик завершения тика: повторяет игровую логику перемещения собак за time_delta
+using TickReplayHandler
+    = std::function<void(model::GameSession& session, std::chrono::milliseconds time_delta)>;
+
+/*
+ * Применяет к сеансам, восстановленным из снимка, записи журнала, сделанные после снимка:
+ * записи тиков, не превосходящих тик сеанса в снимке, пропускаются.
+ * Сеанс, которого не было в снимке, создаётся при первой записи для него.
+ * on_tick вызывается перед завершением каждого воспроизводимого тика
+ */
+void ReplayJournal(std::span<const JournalRecord> records, std::vector<model::GameSession>& sessions,
+                   const TickReplayHandler& on_tick = {});
+
+}  // namespace serialization
@@ -1,9 +1,9 @@
 #pragma once
-#include <memory>
 #include <string>
 #include <vector>
 
 #include "geom.h"
+#include "small_vector.h"
 #include "tagged.h"
 
 namespace model {
@@ -33,6 +33,17 @@ struct FoundObject {
     [[nodiscard]] auto operator<=>(const FoundObject&) const = default;
 };
 
+// Трофей, лежащий на карте
+struct LostObject {
+    using Id = util::Tagged<uint32_t, LostObject>;
+
+    Id id{0u};
+    LostObjectType type{0u};
+    geom::Point2D position;
+
+    [[nodiscard]] auto operator<=>(const LostObject&) const = default;
+};
+
 enum class Direction {
     NORTH,
     EAST,
@@ -43,7 +54,10 @@ enum class Direction {
 class Dog {
 public:
     using Id = util::Tagged<uint32_t, Dog>;
-    using BagContent = std::vector<FoundObject>;
+    // Рюкзак обычно вмещает несколько предметов: такой рюкзак хранится прямо в собаке,
+    // а память в куче выделяется только для рюкзаков большей вместимости
+    static constexpr size_t INLINE_BAG_CAPACITY = 4;
+    using BagContent = util::SmallVector<FoundObject, INLINE_BAG_CAPACITY>;
 
     Dog(Id id, std::string name, geom::Point2D pos, size_t bag_cap)
         : id_(std::move(id))
@@ -127,12 +141,9 @@ private:
     geom::Point2D position_;
     geom::Vec2D speed_;
     Direction direction_{Direction::NORTH};
-    std::vector<FoundObject> bag_;
+    BagContent bag_;
     size_t bag_cap_;
     Score score_{};
 };
 
-using DogPtr = std::shared_ptr<Dog>;
-using ConstDogPtr = std::shared_ptr<const Dog>;
-
 }  // namespace model
@@ -43,7 +43,7 @@ public:
         , speed_(dog.GetSpeed())
         , direction_(dog.GetDirection())
         , score_(dog.GetScore())
-        , bag_content_(dog.GetBagContent()) {
+        , bag_content_(dog.GetBagContent().begin(), dog.GetBagContent().end()) {
     }
 
     [[nodiscard]] model::Dog Restore() const {
@@ -79,7 +79,7 @@ private:
     geom::Vec2D speed_;
     model::Direction direction_ = model::Direction::NORTH;
     model::Score score_ = 0;
-    model::Dog::BagContent bag_content_;
+    std::vector<model::FoundObject> bag_content_;
 };
 
 /* Другие классы модели сериализуются и десериализуются похожим образом */
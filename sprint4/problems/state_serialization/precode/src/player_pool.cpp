@@ -0,0 +1,40 @@
+#include "player_pool.h"
+
+#include <stdexcept>
+
+namespace model {
+
+PlayerHandle PlayerPool::Add(Player player) {
+    uint32_t index;
+    if (!free_slots_.empty()) {
+        index = free_slots_.back();
+        free_slots_.pop_back();
+    } else {
+        if (slot_count_ == UINT32_MAX) {
+            throw std::length_error("Too many players in pool");
+        }
+        if (slot_count_ == chunks_.size() * CHUNK_SIZE) {
+            chunks_.push_back(std::make_unique<Chunk>());
+            // Remove освобождает ячейку, не выделяя памяти
+            free_slots_.reserve(chunks_.size() * CHUNK_SIZE);
+        }
+        index = slot_count_++;
+    }
+
+    Slot& slot = GetSlot(index);
+    slot.player.emplace(std::move(player));
+    return {index, slot.generation};
+}
+
+bool PlayerPool::Remove(PlayerHandle handle) {
+    if (!IsValid(handle)) {
+        return false;
+    }
+    Slot& slot = GetSlot(handle.index);
+    slot.player.reset();
+    ++slot.generation;
+    free_slots_.push_back(handle.index);
+    return true;
+}
+
+}  // namespace model
@@ -0,0 +1,75 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "player_tokens.h"
+
+namespace model {
+
+using PlayerHandle = PoolHandle<Player>;
+
+/*
+ * Пул игроков с дескрипторами из индекса ячейки и поколения, как у DogPool.
+ * В отличие от собак, игроков не обходят подряд, зато PlayerTokens хранит указатели
+ * на них. Поэтому игроки не перемещаются: ячейки выделяются блоками по CHUNK_SIZE,
+ * а освобождённые ячейки переиспользуются без обращения к аллокатору.
+ * Указатель на игрока действителен, пока игрок не удалён из пула
+ */
+class PlayerPool {
+public:
+    static constexpr size_t CHUNK_SIZE = 64;
+
+    PlayerPool() = default;
+
+    PlayerPool(const PlayerPool&) = delete;
+    PlayerPool& operator=(const PlayerPool&) = delete;
+
+    PlayerHandle Add(Player player);
+
+    // Возвращает false, если дескриптор устарел
+    bool Remove(PlayerHandle handle);
+
+    bool IsValid(PlayerHandle handle) const noexcept {
+        return handle.index < slot_count_ && GetSlot(handle.index).generation == handle.generation
+            && GetSlot(handle.index).player.has_value();
+    }
+
+    // Возвращает nullptr для устаревшего дескриптора
+    Player* Get(PlayerHandle handle) noexcept {
+        return IsValid(handle) ? &*GetSlot(handle.index).player : nullptr;
+    }
+
+    const Player* Get(PlayerHandle handle) const noexcept {
+        return IsValid(handle) ? &*GetSlot(handle.index).player : nullptr;
+    }
+
+    size_t GetSize() const noexcept {
+        return slot_count_ - free_slots_.size();
+    }
+
+private:
+    struct Slot {
+        uint32_t generation = 0;
+        std::optional<Player> player;
+    };
+
+    using Chunk = std::array<Slot, CHUNK_SIZE>;
+
+    Slot& GetSlot(uint32_t index) noexcept {
+        return (*chunks_[index / CHUNK_SIZE])[index % CHUNK_SIZE];
+    }
+
+    const Slot& GetSlot(uint32_t index) const noexcept {
+        return (*chunks_[index / CHUNK_SIZE])[index % CHUNK_SIZE];
+    }
+
+    std::vector<std::unique_ptr<Chunk>> chunks_;
+    // Количество ячеек, когда-либо выданных из блоков
+    uint32_t slot_count_ = 0;
+    std::vector<uint32_t> free_slots_;
+};
+
+}  // namespace model
@@ -0,0 +1,188 @@
+#include "player_tokens.h"
+
+#include <stdexcept>
+
+namespace model {
+
+namespace {
+
+constexpr char HEX_DIGITS[] = "0123456789abcdef";
+
+std::optional<uint64_t> ParseHex64(std::string_view hex) noexcept {
+    uint64_t value = 0;
+    for (char c : hex) {
+        uint64_t digit;
+        if (c >= '0' && c <= '9') {
+            digit = c - '0';
+        } else if (c >= 'a' && c <= 'f') {
+            digit = c - 'a' + 10;
+        } else if (c >= 'A' && c <= 'F') {
+            digit = c - 'A' + 10;
+        } else {
+            return std::nullopt;
+        }
+        value = (value << 4) | digit;
+    }
+    return value;
+}
+
+void WriteHex64(uint64_t value, char* out) noexcept {
+    for (int i = 15; i >= 0; --i) {
+        out[i] = HEX_DIGITS[value & 0xF];
+        value >>= 4;
+    }
+}
+
+}  // namespace
+
+std::optional<Token> Token::FromHex(std::string_view hex) noexcept {
+    if (hex.size() != HEX_LENGTH) {
+        return std::nullopt;
+    }
+    const auto hi = ParseHex64(hex.substr(0, HEX_LENGTH / 2));
+    const auto lo = ParseHex64(hex.substr(HEX_LENGTH / 2));
+    if (!hi || !lo) {
+        return std::nullopt;
+    }
+    return Token{*hi, *lo};
+}
+
+std::string Token::ToHex() const {
+    std::string hex(HEX_LENGTH, '0');
+    WriteHex64(hi, hex.data());
+    WriteHex64(lo, hex.data() + HEX_LENGTH / 2);
+    return hex;
+}
+
+PlayerTokens::Shard::Shard()
+    : slots_(INITIAL_SHARD_CAPACITY) {
+}
+
+size_t PlayerTokens::Shard::FindSlot(const Token& token, uint64_t hash) const noexcept {
+    // Ёмкость - степень двойки, а таблица заполнена не более чем наполовину,
+    // поэтому линейное пробирование всегда находит токен или свободную ячейку
+    const size_t mask = slots_.size() - 1;
+    size_t index = hash & mask;
+    while (slots_[index].player && slots_[index].token != token) {
+        index = (index + 1) & mask;
+    }
+    return index;
+}
+
+bool PlayerTokens::Shard::Insert(const Token& token, Player& player, uint64_t hash) {
+    std::unique_lock lock{mutex_};
+    if ((size_ + 1) * 2 > slots_.size()) {
+        Grow();
+    }
+    Slot& slot = slots_[FindSlot(token, hash)];
+    if (slot.player) {
+        return false;
+    }
+    slot = Slot{token, &player};
+    ++size_;
+    return true;
+}
+
+bool PlayerTokens::Shard::Remove(const Token& token, uint64_t hash) {
+    std::unique_lock lock{mutex_};
+    size_t index = FindSlot(token, hash);
+    if (!slots_[index].player) {
+        return false;
+    }
+
+    // Удаление со сдвигом: переносим назад элементы той же цепочки пробирования,
+    // чтобы не оставлять в таблице "надгробий"
+    const size_t mask = slots_.size() - 1;
+    size_t next = index;
+    while (true) {
+        next = (next + 1) & mask;
+        if (!slots_[next].player) {
+            break;
+        }
+        const size_t home = PlayerTokens::Hash(slots_[next].token) & mask;
+        const bool home_in_gap = index <= next ? (index < home && home <= next)
+                                               : (index < home || home <= next);
+        if (!home_in_gap) {
+            slots_[index] = slots_[next];
+            index = next;
+        }
+    }
+    slots_[index] = Slot{};
+    --size_;
+    return true;
+}
+
+Player* PlayerTokens::Shard::Find(const Token& token, uint64_t hash) const noexcept {
+    std::shared_lock lock{mutex_};
+    return slots_[FindSlot(token, hash)].player;
+}
+
+size_t PlayerTokens::Shard::GetSize() const {
+    std::shared_lock lock{mutex_};
+    return size_;
+}
+
+void PlayerTokens::Shard::Grow() {
+    std::vector<Slot> old_slots(slots_.size() * 2);
+    old_slots.swap(slots_);
+    for (const Slot& slot : old_slots) {
+        if (slot.player) {
+            slots_[FindSlot(slot.token, PlayerTokens::Hash(slot.token))] = slot;
+        }
+    }
+}
+
+PlayerTokens::PlayerTokens() = default;
+
+uint64_t PlayerTokens::Hash(const Token& token) noexcept {
+    // Финализатор splitmix64: перемешивает все биты обеих половин токена
+    uint64_t x = token.hi ^ (token.lo * 0x9E3779B97F4A7C15ull);
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+Token PlayerTokens::AddPlayer(Player& player) {
+    while (true) {
+        Token token;
+        {
+            std::lock_guard lock{generator_mutex_};
+            token = Token{generator1_(), generator2_()};
+        }
+        if (Insert(token, player)) {
+            return token;
+        }
+    }
+}
+
+bool PlayerTokens::Insert(const Token& token, Player& player) {
+    const uint64_t hash = Hash(token);
+    return GetShard(hash).Insert(token, player, hash);
+}
+
+bool PlayerTokens::Remove(const Token& token) {
+    const uint64_t hash = Hash(token);
+    return GetShard(hash).Remove(token, hash);
+}
+
+Player* PlayerTokens::FindPlayer(const Token& token) const noexcept {
+    const uint64_t hash = Hash(token);
+    return GetShard(hash).Find(token, hash);
+}
+
+Player* PlayerTokens::FindPlayer(std::string_view hex_token) const noexcept {
+    if (const auto token = Token::FromHex(hex_token)) {
+        return FindPlayer(*token);
+    }
+    return nullptr;
+}
+
+size_t PlayerTokens::GetPlayerCount() const {
+    size_t count = 0;
+    for (const Shard& shard : shards_) {
+        count += shard.GetSize();
+    }
+    return count;
+}
+
+}  // namespace model
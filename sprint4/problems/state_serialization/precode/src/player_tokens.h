@@ -0,0 +1,119 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "game_session.h"
+
+namespace model {
+
+// 128-битный токен авторизации. В HTTP передаётся как 32 шестнадцатеричных символа
+struct Token {
+    uint64_t hi = 0;
+    uint64_t lo = 0;
+
+    static constexpr size_t HEX_LENGTH = 32;
+
+    // Разбирает токен без выделения памяти. Возвращает std::nullopt при неверном формате
+    static std::optional<Token> FromHex(std::string_view hex) noexcept;
+    std::string ToHex() const;
+
+    [[nodiscard]] auto operator<=>(const Token&) const = default;
+};
+
+struct Player {
+    using Id = util::Tagged<uint32_t, Player>;
+
+    Id id{0u};
+    GameSession* session = nullptr;
+    DogHandle dog;
+};
+
+/*
+ * Индекс "токен -> игрок".
+ * Токены хранятся в хеш-таблицах с открытой адресацией, разбитых на сегменты
+ * со своими блокировками, поэтому поиск не выделяет память и не захватывает
+ * общую для всех запросов блокировку.
+ * Индекс не владеет игроками: они должны жить, пока их токен есть в индексе.
+ */
+class PlayerTokens {
+public:
+    PlayerTokens();
+
+    PlayerTokens(const PlayerTokens&) = delete;
+    PlayerTokens& operator=(const PlayerTokens&) = delete;
+
+    // Выдаёт игроку новый случайный токен
+    Token AddPlayer(Player& player);
+
+    // Возвращает false, если такой токен уже выдан
+    bool Insert(const Token& token, Player& player);
+
+    bool Remove(const Token& token);
+
+    Player* FindPlayer(const Token& token) const noexcept;
+    Player* FindPlayer(std::string_view hex_token) const noexcept;
+
+    size_t GetPlayerCount() const;
+
+private:
+    // Номер сегмента определяют старшие биты хеша, ячейку в сегменте - младшие
+    static constexpr int SHARD_BITS = 4;
+    static constexpr size_t SHARD_COUNT = size_t{1} << SHARD_BITS;
+    static constexpr size_t INITIAL_SHARD_CAPACITY = 16;
+
+    struct Slot {
+        Token token;
+        Player* player = nullptr;  // nullptr - ячейка свободна
+    };
+
+    class Shard {
+    public:
+        Shard();
+
+        bool Insert(const Token& token, Player& player, uint64_t hash);
+        bool Remove(const Token& token, uint64_t hash);
+        Player* Find(const Token& token, uint64_t hash) const noexcept;
+        size_t GetSize() const;
+
+    private:
+        // Вызывающий код должен удерживать mutex_
+        size_t FindSlot(const Token& token, uint64_t hash) const noexcept;
+        void Grow();
+
+        mutable std::shared_mutex mutex_;
+        std::vector<Slot> slots_;
+        size_t size_ = 0;
+    };
+
+    static uint64_t Hash(const Token& token) noexcept;
+
+    const Shard& GetShard(uint64_t hash) const noexcept {
+        return shards_[hash >> (64 - SHARD_BITS)];
+    }
+
+    Shard& GetShard(uint64_t hash) noexcept {
+        return shards_[hash >> (64 - SHARD_BITS)];
+    }
+
+    std::array<Shard, SHARD_COUNT> shards_;
+
+    std::mutex generator_mutex_;
+    std::random_device random_device_;
+    std::mt19937_64 generator1_{[this] {
+        std::uniform_int_distribution<std::mt19937_64::result_type> dist;
+        return dist(random_device_);
+    }()};
+    std::mt19937_64 generator2_{[this] {
+        std::uniform_int_distribution<std::mt19937_64::result_type> dist;
+        return dist(random_device_);
+    }()};
+};
+
+}  // namespace model
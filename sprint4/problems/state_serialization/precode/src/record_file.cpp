@@ -0,0 +1,120 @@
+#include "record_file.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <boost/crc.hpp>
+#include <cerrno>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <system_error>
+
+namespace serialization {
+using namespace std::literals;
+
+namespace {
+
+[[noreturn]] void ThrowSystemError(const std::string& what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+}  // namespace
+
+uint32_t RecordChecksum(std::string_view data) {
+    boost::crc_32_type crc;
+    crc.process_bytes(data.data(), data.size());
+    return crc.checksum();
+}
+
+void AppendRecord(std::string& out, std::string_view data) {
+    std::ostringstream header;
+    BinaryWriter writer{header};
+    writer.WriteValue(static_cast<uint32_t>(data.size()));
+    writer.WriteValue(RecordChecksum(data));
+    out += std::move(header).str();
+    out += data;
+}
+
+std::string ReadWholeFile(const std::filesystem::path& path) {
+    std::ifstream in{path, std::ios::binary};
+    if (!in) {
+        throw std::runtime_error("Failed to open "s + path.string());
+    }
+    return {std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+}
+
+RecordFileWriter::RecordFileWriter(std::filesystem::path path)
+    : path_{std::move(path)} {
+    const std::string contents = std::filesystem::exists(path_) ? ReadWholeFile(path_) : std::string{};
+    synced_size_ = ForEachRecordData(contents, [](const std::string&) {});
+    Reopen(synced_size_);
+    if (::fdatasync(fd_) != 0) {
+        const int error = errno;
+        ::close(fd_);
+        errno = error;
+        ThrowSystemError("Failed to sync "s + path_.string());
+    }
+}
+
+RecordFileWriter::~RecordFileWriter() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+void RecordFileWriter::Reopen(uint64_t size) {
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+    fd_ = ::open(path_.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        ThrowSystemError("Failed to open "s + path_.string());
+    }
+    if (::ftruncate(fd_, static_cast<off_t>(size)) != 0) {
+        const int error = errno;
+        ::close(fd_);
+        fd_ = -1;
+        errno = error;
+        ThrowSystemError("Failed to truncate "s + path_.string());
+    }
+}
+
+void RecordFileWriter::Write(std::string_view records) {
+    if (broken_) {
+        Reopen(synced_size_);
+    }
+    broken_ = true;
+    size_t written_total = 0;
+    while (written_total < records.size()) {
+        const ssize_t written
+            = ::write(fd_, records.data() + written_total, records.size() - written_total);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            ThrowSystemError("Failed to write "s + path_.string());
+        }
+        written_total += static_cast<size_t>(written);
+    }
+    if (::fdatasync(fd_) != 0) {
+        ThrowSystemError("Failed to sync "s + path_.string());
+    }
+    broken_ = false;
+    synced_size_ += records.size();
+}
+
+void RecordFileWriter::Truncate() {
+    // После сбоя файл начинается заново с пустого
+    synced_size_ = 0;
+    if (broken_) {
+        Reopen(0);
+    }
+    broken_ = true;
+    if (::ftruncate(fd_, 0) != 0 || ::fdatasync(fd_) != 0) {
+        ThrowSystemError("Failed to truncate "s + path_.string());
+    }
+    broken_ = false;
+}
+
+}  // namespace serialization
@@ -0,0 +1,98 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include "binary_io.h"
+
+namespace serialization {
+
+/*
+ * Файл записей, в который только дописывают: журнал и файл изменений.
+ * Каждая запись - длина и контрольная сумма данных, затем сами данные,
+ * поэтому запись, не дописанная из-за сбоя, обнаруживается при чтении.
+ */
+
+// Заголовок записи: длина и контрольная сумма данных
+constexpr size_t RECORD_HEADER_SIZE = 2 * sizeof(uint32_t);
+
+uint32_t RecordChecksum(std::string_view data);
+
+// Дописывает к out запись с данными data
+void AppendRecord(std::string& out, std::string_view data);
+
+// Читает файл целиком. Выбрасывает std::runtime_error, если файл не открывается
+std::string ReadWholeFile(const std::filesystem::path& path);
+
+/*
+ * Вызывает fn(data) для данных каждой целой записи contents до первой недописанной
+ * или повреждённой. Возвращает длину начала contents, занятого целыми записями
+ */
+template <typename Fn>
+size_t ForEachRecordData(const std::string& contents, Fn&& fn) {
+    std::istringstream strm{contents};
+    BinaryReader reader{strm};
+    size_t valid_size = 0;
+    while (contents.size() - valid_size >= RECORD_HEADER_SIZE) {
+        const auto size = reader.ReadValue<uint32_t>();
+        const auto checksum = reader.ReadValue<uint32_t>();
+        if (size > contents.size() - valid_size - RECORD_HEADER_SIZE) {
+            break;
+        }
+        std::string data;
+        reader.ReadArray(data, size);
+        if (RecordChecksum(data) != checksum) {
+            break;
+        }
+        fn(data);
+        valid_size += RECORD_HEADER_SIZE + size;
+    }
+    return valid_size;
+}
+
+/*
+ * Дописывает записи в файл и дожидается их сохранения на диск.
+ * Ошибки ввода-вывода выбрасываются как std::system_error
+ */
+class RecordFileWriter {
+public:
+    // Открывает файл, создавая его при необходимости. Недописанный хвост, оставшийся
+    // от сбоя посреди записи, отрезается, чтобы новые записи не оказались за ним недоступными
+    explicit RecordFileWriter(std::filesystem::path path);
+
+    RecordFileWriter(const RecordFileWriter&) = delete;
+    RecordFileWriter& operator=(const RecordFileWriter&) = delete;
+
+    ~RecordFileWriter();
+
+    /*
+     * Дописывает records - записи, сформированные AppendRecord, - одной операцией записи
+     * и одним fdatasync. После ошибки записи или fdatasync нельзя доверять ничему, что записано
+     * после последней успешной синхронизации: ядро могло отбросить эти страницы, а следующий
+     * fdatasync сообщил бы об успехе. Поэтому следующий вызов Write или Truncate заново
+     * открывает файл и обрезает его до последней синхронизированной записи
+     */
+    void Write(std::string_view records);
+
+    // Очищает файл и дожидается сохранения на диск
+    void Truncate();
+
+    const std::filesystem::path& GetPath() const noexcept {
+        return path_;
+    }
+
+private:
+    // Открывает файл и обрезает его до длины size
+    void Reopen(uint64_t size);
+
+    std::filesystem::path path_;
+    int fd_ = -1;
+    // Длина файла, сохранённая последним успешным fdatasync
+    uint64_t synced_size_ = 0;
+    // Запись или синхронизация не удалась: файл после synced_size_ надо переписать
+    bool broken_ = false;
+};
+
+}  // namespace serialization
@@ -0,0 +1,114 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace util {
+
+/*
+ * Вектор тривиально копируемых значений, первые InlineCapacity из которых
+ * хранятся внутри самого объекта. В кучу элементы переносятся только тогда,
+ * когда их становится больше (или зарезервировано больше) InlineCapacity.
+ */
+template <typename T, size_t InlineCapacity>
+class SmallVector {
+    static_assert(std::is_trivially_copyable_v<T>, "SmallVector supports trivially copyable types");
+
+public:
+    using value_type = T;
+    using const_iterator = const T*;
+    using iterator = T*;
+
+    SmallVector() = default;
+
+    void reserve(size_t capacity) {
+        if (capacity <= InlineCapacity && !spilled_) {
+            return;
+        }
+        Spill();
+        heap_.reserve(capacity);
+    }
+
+    void push_back(const T& value) {
+        if (!spilled_) {
+            if (size_ < InlineCapacity) {
+                inline_[size_++] = value;
+                return;
+            }
+            Spill();
+        }
+        heap_.push_back(value);
+    }
+
+    void clear() noexcept {
+        size_ = 0;
+        heap_.clear();
+    }
+
+    size_t size() const noexcept {
+        return spilled_ ? heap_.size() : size_;
+    }
+
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    // true - элементы размещены в куче
+    bool is_spilled() const noexcept {
+        return spilled_;
+    }
+
+    T* data() noexcept {
+        return spilled_ ? heap_.data() : inline_.data();
+    }
+
+    const T* data() const noexcept {
+        return spilled_ ? heap_.data() : inline_.data();
+    }
+
+    T& operator[](size_t index) noexcept {
+        return data()[index];
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return data()[index];
+    }
+
+    iterator begin() noexcept {
+        return data();
+    }
+
+    iterator end() noexcept {
+        return data() + size();
+    }
+
+    const_iterator begin() const noexcept {
+        return data();
+    }
+
+    const_iterator end() const noexcept {
+        return data() + size();
+    }
+
+    friend bool operator==(const SmallVector& lhs, const SmallVector& rhs) {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+private:
+    void Spill() {
+        if (!spilled_) {
+            heap_.assign(inline_.begin(), inline_.begin() + size_);
+            size_ = 0;
+            spilled_ = true;
+        }
+    }
+
+    std::array<T, InlineCapacity> inline_{};
+    size_t size_ = 0;
+    bool spilled_ = false;
+    std::vector<T> heap_;
+};
+
+}  // namespace util
@@ -0,0 +1,92 @@
+#include "state_change_log.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace model {
+
+namespace {
+
+template <typename T>
+void SortUnique(std::vector<T>& values) {
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+}
+
+// Добавляет к отсортированным значениям values отсортированные значения added без повторов
+template <typename T>
+void MergeUnique(std::vector<T>& values, const std::vector<T>& added) {
+    const auto middle = static_cast<std::ptrdiff_t>(values.size());
+    values.insert(values.end(), added.begin(), added.end());
+    std::inplace_merge(values.begin(), values.begin() + middle, values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+}
+
+}  // namespace
+
+StateChangeLog::StateChangeLog(size_t history_depth)
+    : ring_(history_depth) {
+    if (history_depth == 0) {
+        throw std::invalid_argument("History depth must be positive");
+    }
+}
+
+void StateChangeLog::TouchDog(Dog::Id id) {
+    current_.dogs.push_back(id);
+}
+
+void StateChangeLog::TouchLostObject(LostObject::Id id) {
+    current_.lost_objects.push_back(id);
+}
+
+Tick StateChangeLog::CommitTick() {
+    SortUnique(current_.dogs);
+    SortUnique(current_.lost_objects);
+    MergeUnique(unsaved_.dogs, current_.dogs);
+    MergeUnique(unsaved_.lost_objects, current_.lost_objects);
+
+    ++tick_;
+    // Ячейку вытесненного тика переиспользуем, чтобы не выделять память заново
+    ChangeSet& slot = ring_[tick_ % ring_.size()];
+    std::swap(slot, current_);
+    current_.dogs.clear();
+    current_.lost_objects.clear();
+    return tick_;
+}
+
+void StateChangeLog::Reset(Tick tick) {
+    for (ChangeSet& changes : ring_) {
+        changes.dogs.clear();
+        changes.lost_objects.clear();
+    }
+    current_.dogs.clear();
+    current_.lost_objects.clear();
+    unsaved_.dogs.clear();
+    unsaved_.lost_objects.clear();
+    tick_ = tick;
+    base_tick_ = tick;
+}
+
+StateChangeLog::ChangedIds StateChangeLog::TakeUnsavedChanges() {
+    return std::exchange(unsaved_, {});
+}
+
+std::optional<StateChangeLog::ChangedIds> StateChangeLog::GetChangesSince(Tick since) const {
+    if (since > tick_ || since < base_tick_ || tick_ - since > ring_.size()) {
+        return std::nullopt;
+    }
+
+    ChangedIds result;
+    for (Tick t = since + 1; t <= tick_; ++t) {
+        const ChangeSet& changes = ring_[t % ring_.size()];
+        result.dogs.insert(result.dogs.end(), changes.dogs.begin(), changes.dogs.end());
+        result.lost_objects.insert(result.lost_objects.end(), changes.lost_objects.begin(),
+                                   changes.lost_objects.end());
+    }
+    SortUnique(result.dogs);
+    SortUnique(result.lost_objects);
+    return result;
+}
+
+}  // namespace model
@@ -0,0 +1,73 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "model.h"
+
+namespace model {
+
+using Tick = uint64_t;
+
+/*
+ * Журнал изменений игрового состояния за последние history_depth тиков.
+ * Хранит для каждого тика идентификаторы собак и трофеев, которые в нём изменились,
+ * в кольцевом буфере фиксированного размера.
+ */
+class StateChangeLog {
+public:
+    // Идентификаторы объектов, изменившихся за несколько тиков (отсортированы, без повторов)
+    struct ChangedIds {
+        std::vector<Dog::Id> dogs;
+        std::vector<LostObject::Id> lost_objects;
+    };
+
+    explicit StateChangeLog(size_t history_depth);
+
+    // Отмечают объект изменённым (добавленным, изменённым или удалённым) в текущем тике
+    void TouchDog(Dog::Id id);
+    void TouchLostObject(LostObject::Id id);
+
+    // Завершает текущий тик и возвращает его номер
+    Tick CommitTick();
+
+    // Начинает журнал заново с тика tick, например после восстановления состояния.
+    // Изменения до tick неизвестны, и клиентам, отставшим от него, нужен полный снимок
+    void Reset(Tick tick);
+
+    /*
+     * Возвращает объекты, изменившиеся в завершённых тиках с прошлого вызова, и забывает их.
+     * В отличие от GetChangesSince, не ограничена глубиной истории: по ней сохраняются
+     * лишь изменённые объекты, как бы редко ни выполнялось сохранение
+     */
+    ChangedIds TakeUnsavedChanges();
+
+    // Номер последнего завершённого тика
+    Tick GetTick() const noexcept {
+        return tick_;
+    }
+
+    size_t GetHistoryDepth() const noexcept {
+        return ring_.size();
+    }
+
+    /*
+     * Возвращает объекты, изменившиеся в тиках (since, GetTick()].
+     * Если тик since уже вытеснен из кольцевого буфера или ещё не наступил,
+     * возвращает std::nullopt: клиенту нужен полный снимок состояния.
+     */
+    std::optional<ChangedIds> GetChangesSince(Tick since) const;
+
+private:
+    using ChangeSet = ChangedIds;
+
+    std::vector<ChangeSet> ring_;
+    ChangeSet current_;
+    // Объекты, изменённые в завершённых тиках с прошлого TakeUnsavedChanges
+    ChangeSet unsaved_;
+    Tick tick_ = 0;
+    // Тик, с которого ведётся журнал
+    Tick base_tick_ = 0;
+};
+
+}  // namespace model
@@ -0,0 +1,58 @@
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+
+#include "../src/background_snapshot.h"
+#include "temp_dir.h"
+
+using namespace model;
+using namespace serialization;
+using namespace std::literals;
+using test_util::TempDir;
+
+SCENARIO("Background snapshots") {
+    TempDir dir{"background-snapshot-tests"s};
+    const auto snapshot_path = dir.path / "state.bin"s;
+
+    GIVEN("a session and a background writer") {
+        GameSession session{GameSession::MapId{"map1"s}};
+        BackgroundSnapshotWriter writer{snapshot_path};
+
+        WHEN("the game keeps changing the session while snapshots are written") {
+            std::vector<SessionSnapshot> last;
+            for (uint32_t tick = 0; tick < 50; ++tick) {
+                session.AddDog(Dog{Dog::Id{tick}, "Dog"s + std::to_string(tick), {tick * 1.0, 0.0}, 3});
+                session.CommitTick();
+                last = {CaptureSession(session)};
+                writer.Schedule(last);
+            }
+            writer.Flush();
+
+            THEN("the file holds the last scheduled snapshot") {
+                CHECK(LoadSnapshotFile(snapshot_path) == last);
+                CHECK(writer.GetWrittenCount() >= 1);
+                CHECK(writer.GetWrittenCount() <= 50);
+                CHECK_FALSE(std::filesystem::exists(snapshot_path.string() + ".tmp"s));
+            }
+        }
+    }
+
+    GIVEN("a writer destroyed right after scheduling") {
+        const std::vector snapshots{CaptureSession(GameSession{GameSession::MapId{"map1"s}})};
+        BackgroundSnapshotWriter{snapshot_path}.Schedule(snapshots);
+
+        THEN("the snapshot is written anyway") {
+            CHECK(LoadSnapshotFile(snapshot_path) == snapshots);
+        }
+    }
+
+    GIVEN("a writer to a missing directory") {
+        BackgroundSnapshotWriter writer{dir.path / "missing"s / "state.bin"s};
+        writer.Schedule({});
+
+        THEN("the error is reported by Flush once") {
+            CHECK_THROWS_AS(writer.Flush(), std::runtime_error);
+            CHECK_NOTHROW(writer.Flush());
+            CHECK(writer.GetWrittenCount() == 0);
+        }
+    }
+}
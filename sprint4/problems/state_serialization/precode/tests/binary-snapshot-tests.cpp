@@ -0,0 +1,158 @@
+#include <boost/archive/text_oarchive.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <sstream>
+
+#include "../src/binary_snapshot.h"
+#include "../src/model_serialization.h"
+
+using namespace model;
+using namespace serialization;
+using namespace std::literals;
+
+namespace {
+
+GameSession MakeSession() {
+    GameSession session{GameSession::MapId{"map1"s}};
+
+    Dog pluto{Dog::Id{42}, "Pluto"s, {42.2, 12.5}, 3};
+    pluto.AddScore(42);
+    CHECK(pluto.PutToBag({FoundObject::Id{10}, 2u}));
+    pluto.SetDirection(Direction::EAST);
+    pluto.SetSpeed({2.3, -1.2});
+    session.AddDog(std::move(pluto));
+
+    // Рюкзак больше встроенного
+    Dog rex{Dog::Id{7}, "Рекс"s, {-1.0, 0.125}, 8};
+    for (uint32_t i = 0; i < 6; ++i) {
+        CHECK(rex.PutToBag({FoundObject::Id{100 + i}, i}));
+    }
+    rex.SetDirection(Direction::SOUTH);
+    session.AddDog(std::move(rex));
+
+    session.AddDog(Dog{Dog::Id{8}, ""s, {0.0, 0.0}, 0});
+
+    session.AddLostObject({LostObject::Id{1}, 3u, {1.5, 2.5}});
+    session.AddLostObject({LostObject::Id{2}, 0u, {-7.0, 1e10}});
+    session.CommitTick();
+    session.CommitTick();
+    return session;
+}
+
+void CheckSameDogs(const GameSession& expected, const GameSession& actual) {
+    REQUIRE(expected.GetDogs().size() == actual.GetDogs().size());
+    for (const Dog& dog : expected.GetDogs()) {
+        INFO("dog: " << *dog.GetId());
+        const Dog* restored = actual.FindDog(dog.GetId());
+        REQUIRE(restored);
+        CHECK(dog.GetName() == restored->GetName());
+        CHECK(dog.GetPosition() == restored->GetPosition());
+        CHECK(dog.GetSpeed() == restored->GetSpeed());
+        CHECK(dog.GetDirection() == restored->GetDirection());
+        CHECK(dog.GetScore() == restored->GetScore());
+        CHECK(dog.GetBagCapacity() == restored->GetBagCapacity());
+        CHECK(dog.GetBagContent() == restored->GetBagContent());
+    }
+}
+
+}  // namespace
+
+SCENARIO("Binary game state snapshot") {
+    GIVEN("game sessions") {
+        const GameSession session = MakeSession();
+        const GameSession empty_session{GameSession::MapId{"map2"s}};
+        const std::vector snapshots{CaptureSession(session), CaptureSession(empty_session)};
+
+        WHEN("they are written and read back") {
+            std::stringstream strm;
+            WriteSnapshot(strm, snapshots);
+            const auto restored_snapshots = ReadSnapshot(strm);
+
+            THEN("snapshots are the same") {
+                CHECK(restored_snapshots == snapshots);
+            }
+
+            THEN("sessions are restored with their tick") {
+                REQUIRE(restored_snapshots.size() == 2);
+                const GameSession restored = RestoreSession(restored_snapshots[0]);
+                CHECK(restored.GetMapId() == session.GetMapId());
+                CHECK(restored.GetTick() == session.GetTick());
+                CheckSameDogs(session, restored);
+                for (const LostObject& obj : session.GetLostObjects()) {
+                    const LostObject* restored_obj = restored.FindLostObject(obj.id);
+                    REQUIRE(restored_obj);
+                    CHECK(*restored_obj == obj);
+                }
+
+                AND_THEN("clients that knew an older tick get the full state") {
+                    CHECK(restored.GetStateSince(session.GetTick() - 1).is_full);
+                    CHECK_FALSE(restored.GetStateSince(session.GetTick()).is_full);
+                }
+            }
+        }
+
+        WHEN("the same dogs are saved with a text archive") {
+            std::stringstream text;
+            {
+                boost::archive::text_oarchive archive{text};
+                for (const Dog& dog : session.GetDogs()) {
+                    DogRepr repr{dog};
+                    archive << repr;
+                }
+            }
+            std::stringstream binary;
+            WriteSnapshot(binary, std::span{snapshots}.first(1));
+
+            THEN("binary snapshot is smaller") {
+                CHECK(binary.str().size() < text.str().size());
+            }
+        }
+    }
+
+    GIVEN("damaged data") {
+        std::stringstream strm;
+        const std::vector snapshots{CaptureSession(MakeSession())};
+        WriteSnapshot(strm, snapshots);
+        const std::string data = strm.str();
+
+        THEN("truncated snapshot is rejected") {
+            for (size_t size : {size_t{0}, size_t{3}, size_t{10}, data.size() / 2, data.size() - 1}) {
+                INFO("size: " << size);
+                std::stringstream truncated{data.substr(0, size)};
+                CHECK_THROWS_AS(ReadSnapshot(truncated), std::runtime_error);
+            }
+        }
+
+        THEN("snapshot of another format or version is rejected") {
+            std::string wrong_magic = data;
+            wrong_magic[0] = 'X';
+            std::stringstream wrong_magic_strm{wrong_magic};
+            CHECK_THROWS_AS(ReadSnapshot(wrong_magic_strm), std::runtime_error);
+
+            std::string wrong_version = data;
+            wrong_version[4] = static_cast<char>(SNAPSHOT_FORMAT_VERSION + 1);
+            std::stringstream wrong_version_strm{wrong_version};
+            CHECK_THROWS_AS(ReadSnapshot(wrong_version_strm), std::runtime_error);
+        }
+
+        THEN("inconsistent snapshot cannot be restored") {
+            SessionSnapshot snapshot = snapshots[0];
+            snapshot.dog_bag_sizes[0] += 1;
+            CHECK_THROWS_AS(RestoreSession(snapshot), std::runtime_error);
+        }
+
+        THEN("snapshot with repeated ids cannot be restored") {
+            SessionSnapshot dogs_snapshot = snapshots[0];
+            REQUIRE(dogs_snapshot.dog_ids.size() >= 2);
+            dogs_snapshot.dog_ids[1] = dogs_snapshot.dog_ids[0];
+            CHECK_THROWS_AS(RestoreSession(dogs_snapshot), std::runtime_error);
+
+            SessionSnapshot objects_snapshot = snapshots[0];
+            REQUIRE(!objects_snapshot.lost_object_ids.empty());
+            objects_snapshot.lost_object_ids.push_back(objects_snapshot.lost_object_ids[0]);
+            objects_snapshot.lost_object_types.push_back(objects_snapshot.lost_object_types[0]);
+            objects_snapshot.lost_object_x.push_back(objects_snapshot.lost_object_x[0]);
+            objects_snapshot.lost_object_y.push_back(objects_snapshot.lost_object_y[0]);
+            CHECK_THROWS_AS(RestoreSession(objects_snapshot), std::runtime_error);
+        }
+    }
+}
@@ -0,0 +1,59 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/dog_pool.h"
+
+using namespace model;
+using namespace std::literals;
+
+namespace {
+
+Dog MakeDog(uint32_t id) {
+    return Dog{Dog::Id{id}, "Dog"s + std::to_string(id), {0.0, 0.0}, 3};
+}
+
+}  // namespace
+
+SCENARIO("Dog pool") {
+    GIVEN("a pool with three dogs") {
+        DogPool pool;
+        const DogHandle first = pool.Add(MakeDog(1));
+        const DogHandle second = pool.Add(MakeDog(2));
+        const DogHandle third = pool.Add(MakeDog(3));
+
+        THEN("dogs are accessible by handles") {
+            CHECK(pool.GetSize() == 3);
+            REQUIRE(pool.Get(second) != nullptr);
+            CHECK(pool.Get(second)->GetId() == Dog::Id{2});
+        }
+
+        WHEN("a dog is removed") {
+            REQUIRE(pool.Remove(first));
+
+            THEN("its handle becomes stale") {
+                CHECK_FALSE(pool.IsValid(first));
+                CHECK(pool.Get(first) == nullptr);
+                CHECK_FALSE(pool.Remove(first));
+            }
+
+            THEN("handles of other dogs stay valid and dogs stay contiguous") {
+                CHECK(pool.GetDogs().size() == 2);
+                CHECK(pool.Get(second)->GetId() == Dog::Id{2});
+                CHECK(pool.Get(third)->GetId() == Dog::Id{3});
+                for (size_t i = 0; i < pool.GetDogs().size(); ++i) {
+                    CHECK(pool.Get(pool.GetHandle(i)) == &pool.GetDogs()[i]);
+                }
+            }
+
+            AND_WHEN("another dog is added") {
+                const DogHandle fourth = pool.Add(MakeDog(4));
+
+                THEN("the freed slot is reused with a new generation") {
+                    CHECK(fourth.index == first.index);
+                    CHECK(fourth.generation != first.generation);
+                    CHECK(pool.Get(first) == nullptr);
+                    CHECK(pool.Get(fourth)->GetId() == Dog::Id{4});
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,129 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/game_session.h"
+
+using namespace model;
+using namespace std::literals;
+
+namespace {
+
+Dog MakeDog(uint32_t id) {
+    return Dog{Dog::Id{id}, "Dog"s + std::to_string(id), {0.0, 0.0}, 3};
+}
+
+std::vector<Dog::Id> GetDogIds(const GameSession::StateUpdate& update) {
+    std::vector<Dog::Id> ids;
+    for (const Dog* dog : update.dogs) {
+        ids.push_back(dog->GetId());
+    }
+    return ids;
+}
+
+}  // namespace
+
+SCENARIO("Game session state updates") {
+    GIVEN("a session with two dogs and a lost object") {
+        GameSession session{GameSession::MapId{"map1"s}, 4};
+        session.AddDog(MakeDog(1));
+        session.AddDog(MakeDog(2));
+        session.AddLostObject({LostObject::Id{7}, 1u, {1.0, 0.0}});
+        const Tick start_tick = session.CommitTick();
+
+        WHEN("client is up to date") {
+            const auto update = session.GetStateSince(start_tick);
+
+            THEN("update is empty") {
+                CHECK_FALSE(update.is_full);
+                CHECK(update.tick == start_tick);
+                CHECK(update.dogs.empty());
+                CHECK(update.lost_objects.empty());
+                CHECK(update.removed_dogs.empty());
+                CHECK(update.removed_lost_objects.empty());
+            }
+        }
+
+        WHEN("one dog moves and the lost object is collected") {
+            session.UpdateDog(Dog::Id{2}, [](Dog& dog) {
+                dog.SetPosition({0.5, 0.0});
+            });
+            session.CommitTick();
+            session.RemoveLostObject(LostObject::Id{7});
+            const Tick tick = session.CommitTick();
+
+            THEN("only changed objects are reported") {
+                const auto update = session.GetStateSince(start_tick);
+                CHECK_FALSE(update.is_full);
+                CHECK(update.tick == tick);
+                CHECK(GetDogIds(update) == std::vector{Dog::Id{2}});
+                CHECK(update.dogs.front()->GetPosition() == geom::Point2D{0.5, 0.0});
+                CHECK(update.lost_objects.empty());
+                CHECK(update.removed_lost_objects == std::vector{LostObject::Id{7}});
+            }
+
+            THEN("changes of earlier ticks are not repeated") {
+                const auto update = session.GetStateSince(tick - 1);
+                CHECK(update.dogs.empty());
+                CHECK(update.removed_lost_objects == std::vector{LostObject::Id{7}});
+            }
+        }
+
+        WHEN("a dog leaves the session") {
+            session.RemoveDog(Dog::Id{1});
+            session.CommitTick();
+
+            THEN("it is reported as removed") {
+                const auto update = session.GetStateSince(start_tick);
+                CHECK(update.dogs.empty());
+                CHECK(update.removed_dogs == std::vector{Dog::Id{1}});
+                REQUIRE(session.FindDog(Dog::Id{2}) != nullptr);
+                CHECK(session.FindDog(Dog::Id{2})->GetId() == Dog::Id{2});
+                CHECK(session.GetDog(*session.FindDogHandle(Dog::Id{2})) == session.FindDog(Dog::Id{2}));
+            }
+        }
+
+        WHEN("client is further behind than the history depth") {
+            for (int i = 0; i < 5; ++i) {
+                session.CommitTick();
+            }
+
+            THEN("full state is returned") {
+                const auto update = session.GetStateSince(start_tick);
+                CHECK(update.is_full);
+                CHECK(update.dogs.size() == 2);
+                CHECK(update.lost_objects.size() == 1);
+            }
+        }
+
+        WHEN("changes are saved less often than the history depth") {
+            session.TakeUnsavedChanges();
+            session.UpdateDog(Dog::Id{1}, [](Dog& dog) {
+                dog.SetPosition({0.0, 0.5});
+            });
+            session.CommitTick();
+            for (int i = 0; i < 5; ++i) {
+                session.CommitTick();
+            }
+            session.RemoveLostObject(LostObject::Id{7});
+            const auto changes = session.TakeUnsavedChanges();
+
+            THEN("all changes of committed ticks are taken once") {
+                CHECK(changes.dogs == std::vector{Dog::Id{1}});
+                CHECK(changes.lost_objects.empty());
+                CHECK(session.TakeUnsavedChanges().dogs.empty());
+            }
+
+            THEN("changes of the current tick are taken after it is committed") {
+                session.CommitTick();
+                const auto next_changes = session.TakeUnsavedChanges();
+                CHECK(next_changes.dogs.empty());
+                CHECK(next_changes.lost_objects == std::vector{LostObject::Id{7}});
+            }
+        }
+
+        WHEN("client reports a tick from the future") {
+            THEN("full state is returned") {
+                CHECK(session.GetStateSince(start_tick + 1).is_full);
+            }
+        }
+    }
+}
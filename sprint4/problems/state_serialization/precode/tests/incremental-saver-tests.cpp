@@ -0,0 +1,170 @@
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
+
+#include "../src/incremental_saver.h"
+#include "temp_dir.h"
+
+using namespace model;
+using namespace serialization;
+using namespace std::literals;
+using test_util::TempDir;
+
+namespace {
+
+constexpr uint32_t DOG_COUNT = 1000;
+
+std::vector<GameSession> MakeSessions() {
+    std::vector<GameSession> sessions;
+    GameSession& session = sessions.emplace_back(GameSession::MapId{"map1"s});
+    for (uint32_t i = 0; i < DOG_COUNT; ++i) {
+        session.AddDog(Dog{Dog::Id{i}, "Dog"s + std::to_string(i), {i * 1.0, 0.0}, 3});
+    }
+    session.AddLostObject({LostObject::Id{1}, 2u, {1.5, 0.0}});
+    session.CommitTick();
+    sessions.emplace_back(GameSession::MapId{"map2"s});
+    return sessions;
+}
+
+void MoveDog(GameSession& session, uint32_t id) {
+    session.UpdateDog(Dog::Id{id}, [](Dog& dog) {
+        dog.SetPosition(dog.GetPosition() + geom::Vec2D{0.0, 0.25});
+        dog.SetSpeed({0.0, 1.0});
+        dog.SetDirection(Direction::SOUTH);
+    });
+}
+
+void CheckSameState(const std::vector<GameSession>& expected, const std::vector<GameSession>& actual) {
+    REQUIRE(expected.size() == actual.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        INFO("map: " << *expected[i].GetMapId());
+        CHECK(CaptureSession(expected[i]) == CaptureSession(actual[i]));
+    }
+}
+
+}  // namespace
+
+SCENARIO("Incremental game state saving") {
+    GIVEN("saved game sessions") {
+        TempDir dir{"incremental-saver-tests"s};
+        const auto snapshot_path = dir.path / "state.bin"s;
+        const auto delta_path = dir.path / "state.delta"s;
+        std::vector<GameSession> sessions = MakeSessions();
+        IncrementalSaver saver{snapshot_path, delta_path};
+        REQUIRE(saver.Save(sessions));
+        const auto snapshot_size = std::filesystem::file_size(snapshot_path);
+
+        THEN("the first save writes a full snapshot") {
+            CHECK(saver.GetDeltaSize() == 0);
+            CheckSameState(sessions, LoadIncrementalState(snapshot_path, delta_path));
+        }
+
+        WHEN("nothing changes") {
+            sessions[0].CommitTick();
+
+            THEN("nothing is written") {
+                CHECK_FALSE(saver.Save(sessions));
+                CHECK(saver.GetDeltaSize() == 0);
+            }
+        }
+
+        WHEN("a few dogs move in several ticks") {
+            MoveDog(sessions[0], 1);
+            sessions[0].CommitTick();
+            MoveDog(sessions[0], 2);
+            MoveDog(sessions[0], 1);
+            sessions[0].CommitTick();
+            REQUIRE_FALSE(saver.Save(sessions));
+
+            THEN("only changed dogs are written") {
+                CHECK(saver.GetDeltaSize() > 0);
+                CHECK(saver.GetDeltaSize() * 20 < snapshot_size);
+                CHECK(std::filesystem::file_size(snapshot_path) == snapshot_size);
+            }
+
+            THEN("state is restored from snapshot and changes") {
+                CheckSameState(sessions, LoadIncrementalState(snapshot_path, delta_path));
+            }
+        }
+
+        WHEN("objects are added and removed between saves") {
+            sessions[0].RemoveDog(Dog::Id{3});
+            sessions[0].AddDog(Dog{Dog::Id{DOG_COUNT}, "Newcomer"s, {0.0, 1.0}, 3});
+            sessions[0].RemoveLostObject(LostObject::Id{1});
+            sessions[0].AddLostObject({LostObject::Id{2}, 0u, {2.0, 0.0}});
+            sessions[0].CommitTick();
+            REQUIRE_FALSE(saver.Save(sessions));
+
+            // Появившиеся и исчезнувшие между сохранениями объекты
+            sessions[0].AddDog(Dog{Dog::Id{DOG_COUNT + 1}, "Guest"s, {0.0, 1.0}, 3});
+            sessions[0].AddLostObject({LostObject::Id{3}, 0u, {3.0, 0.0}});
+            sessions[0].CommitTick();
+            sessions[0].RemoveDog(Dog::Id{DOG_COUNT + 1});
+            sessions[0].RemoveLostObject(LostObject::Id{3});
+            sessions[1].AddLostObject({LostObject::Id{4}, 1u, {0.0, 0.0}});
+            sessions[1].CommitTick();
+            REQUIRE_FALSE(saver.Save(sessions));
+
+            THEN("state is restored from snapshot and changes") {
+                const auto restored = LoadIncrementalState(snapshot_path, delta_path);
+                CheckSameState(sessions, restored);
+                CHECK(restored[0].GetTick() == sessions[0].GetTick());
+                CHECK(restored[1].GetTick() == sessions[1].GetTick());
+            }
+        }
+
+        WHEN("changes outgrow the snapshot") {
+            bool compacted = false;
+            int saves = 0;
+            for (; saves < 100 && !compacted; ++saves) {
+                for (uint32_t id = 0; id < DOG_COUNT / 4; ++id) {
+                    MoveDog(sessions[0], id);
+                }
+                sessions[0].CommitTick();
+                compacted = saver.Save(sessions);
+            }
+
+            THEN("they are compacted into a new snapshot") {
+                CHECK(compacted);
+                CHECK(saves > 1);
+                CHECK(saver.GetDeltaSize() == 0);
+                CHECK(std::filesystem::file_size(delta_path) == 0);
+                CheckSameState(sessions, LoadIncrementalState(snapshot_path, delta_path));
+            }
+        }
+
+        WHEN("the last save is torn") {
+            MoveDog(sessions[0], 1);
+            sessions[0].CommitTick();
+            REQUIRE_FALSE(saver.Save(sessions));
+            const auto saved = LoadIncrementalState(snapshot_path, delta_path);
+            const auto good_size = std::filesystem::file_size(delta_path);
+
+            MoveDog(sessions[0], 2);
+            sessions[0].CommitTick();
+            REQUIRE_FALSE(saver.Save(sessions));
+            std::filesystem::resize_file(delta_path, std::filesystem::file_size(delta_path) - 1);
+
+            THEN("state of the previous save is restored") {
+                CHECK(std::filesystem::file_size(delta_path) > good_size);
+                CheckSameState(saved, LoadIncrementalState(snapshot_path, delta_path));
+            }
+        }
+
+        WHEN("snapshot is newer than changes left after a crash") {
+            MoveDog(sessions[0], 1);
+            sessions[0].CommitTick();
+            REQUIRE_FALSE(saver.Save(sessions));
+            const auto stale_path = dir.path / "stale.delta"s;
+            std::filesystem::copy_file(delta_path, stale_path);
+
+            sessions[0].RemoveDog(Dog::Id{1});
+            sessions[0].CommitTick();
+            saver.Compact(sessions);
+
+            THEN("outdated changes are skipped") {
+                CheckSameState(sessions, LoadIncrementalState(snapshot_path, stale_path));
+            }
+        }
+    }
+}
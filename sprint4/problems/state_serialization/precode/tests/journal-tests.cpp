@@ -0,0 +1,219 @@
+#include <sys/resource.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <csignal>
+#include <filesystem>
+#include <system_error>
+
+#include "../src/binary_snapshot.h"
+#include "../src/journal.h"
+#include "temp_dir.h"
+
+using namespace model;
+using namespace serialization;
+using namespace std::literals;
+using test_util::TempDir;
+
+namespace {
+
+// Ограничивает размер файлов, в которые пишет процесс: запись сверх предела
+// завершается частично, а затем ошибкой EFBIG (сигнал SIGXFSZ игнорируется)
+class FileSizeLimit {
+public:
+    explicit FileSizeLimit(rlim_t limit) {
+        ::getrlimit(RLIMIT_FSIZE, &old_limit_);
+        old_handler_ = std::signal(SIGXFSZ, SIG_IGN);
+        rlimit new_limit = old_limit_;
+        new_limit.rlim_cur = limit;
+        ::setrlimit(RLIMIT_FSIZE, &new_limit);
+    }
+
+    FileSizeLimit(const FileSizeLimit&) = delete;
+    FileSizeLimit& operator=(const FileSizeLimit&) = delete;
+
+    ~FileSizeLimit() {
+        ::setrlimit(RLIMIT_FSIZE, &old_limit_);
+        std::signal(SIGXFSZ, old_handler_);
+    }
+
+private:
+    rlimit old_limit_{};
+    void (*old_handler_)(int) = nullptr;
+};
+
+// Упрощённая игровая логика: собаки движутся прямолинейно
+void MoveDogs(GameSession& session, std::chrono::milliseconds time_delta) {
+    std::vector<Dog::Id> ids;
+    for (const Dog& dog : session.GetDogs()) {
+        ids.push_back(dog.GetId());
+    }
+    for (const Dog::Id& id : ids) {
+        session.UpdateDog(id, [time_delta](Dog& dog) {
+            auto position = dog.GetPosition();
+            position += dog.GetSpeed() * std::chrono::duration<double>{time_delta}.count();
+            dog.SetPosition(position);
+        });
+    }
+}
+
+/*
+ * Сервер, записывающий свои действия в журнал
+ */
+class JournaledGame {
+public:
+    explicit JournaledGame(const std::filesystem::path& journal_path)
+        : journal{journal_path} {
+    }
+
+    void Apply(const JournalRecord& record) {
+        journal.Append(record);
+        std::vector sessions{std::move(session)};
+        ReplayJournal(std::span{&record, 1}, sessions, MoveDogs);
+        session = std::move(sessions.front());
+    }
+
+    Tick NextTick() const {
+        return session.GetTick() + 1;
+    }
+
+    void CompleteTick(std::chrono::milliseconds time_delta) {
+        Apply(journal::TickCompleted{"map1"s, NextTick(), time_delta});
+        journal.Commit();
+    }
+
+    GameSession session{GameSession::MapId{"map1"s}};
+    JournalWriter journal;
+};
+
+}  // namespace
+
+SCENARIO("Write-ahead journal") {
+    TempDir dir{"journal-tests"s};
+    const auto journal_path = dir.path / "journal.bin"s;
+
+    GIVEN("records of every kind") {
+        const std::vector<JournalRecord> records{
+            journal::DogJoined{"map1"s, 1, Dog::Id{3}, "Rex"s, {1.5, -2.0}, 3},
+            journal::DogMoved{"map1"s, 1, Dog::Id{3}, Direction::WEST, {-1.0, 0.0}},
+            journal::LootSpawned{"map1"s, 1, {LostObject::Id{5}, 2u, {0.5, -2.0}}},
+            journal::TickCompleted{"map1"s, 1, 100ms},
+            journal::LootPickedUp{"map1"s, 2, Dog::Id{3}, LostObject::Id{5}},
+            journal::DogRetired{"map1"s, 2, Dog::Id{3}},
+        };
+        JournalWriter writer{journal_path};
+        for (const auto& record : records) {
+            writer.Append(record);
+        }
+
+        WHEN("they are not committed") {
+            THEN("the journal is empty") {
+                CHECK(writer.GetPendingSize() > 0);
+                CHECK(ReadJournal(journal_path).empty());
+            }
+        }
+
+        WHEN("they are committed") {
+            writer.Commit();
+
+            THEN("they are read back") {
+                CHECK(writer.GetPendingSize() == 0);
+                CHECK(ReadJournal(journal_path) == records);
+            }
+
+            AND_WHEN("the last record is torn") {
+                std::filesystem::resize_file(journal_path, std::filesystem::file_size(journal_path) - 3);
+
+                THEN("records before it are read") {
+                    const auto read = ReadJournal(journal_path);
+                    CHECK(read == std::vector(records.begin(), records.end() - 1));
+                }
+
+                AND_WHEN("the journal is reopened and more records are committed") {
+                    JournalWriter reopened{journal_path};
+                    reopened.Append(records.front());
+                    reopened.Commit();
+
+                    THEN("the torn record is replaced by the new ones") {
+                        auto expected = std::vector(records.begin(), records.end() - 1);
+                        expected.push_back(records.front());
+                        CHECK(ReadJournal(journal_path) == expected);
+                    }
+                }
+            }
+
+            AND_WHEN("a later commit is interrupted in the middle") {
+                const auto committed_size = std::filesystem::file_size(journal_path);
+                for (const auto& record : records) {
+                    writer.Append(record);
+                }
+                {
+                    FileSizeLimit limit{committed_size + writer.GetPendingSize() / 2};
+                    CHECK_THROWS_AS(writer.Commit(), std::system_error);
+                }
+                writer.Commit();
+
+                THEN("the retried commit rewrites the batch without duplicating records") {
+                    auto expected = records;
+                    expected.insert(expected.end(), records.begin(), records.end());
+                    CHECK(ReadJournal(journal_path) == expected);
+                }
+            }
+
+            AND_WHEN("the journal is truncated") {
+                writer.Truncate();
+                writer.Append(records.front());
+                writer.Commit();
+
+                THEN("only new records remain") {
+                    CHECK(ReadJournal(journal_path) == std::vector{records.front()});
+                }
+            }
+        }
+    }
+
+    GIVEN("a game that saved a snapshot and kept journaling") {
+        const auto snapshot_path = dir.path / "state.bin"s;
+        JournaledGame game{journal_path};
+
+        game.Apply(journal::DogJoined{"map1"s, game.NextTick(), Dog::Id{1}, "Pluto"s, {0.0, 0.0}, 3});
+        game.Apply(journal::DogMoved{"map1"s, game.NextTick(), Dog::Id{1}, Direction::EAST, {2.0, 0.0}});
+        game.Apply(journal::LootSpawned{"map1"s, game.NextTick(), {LostObject::Id{7}, 1u, {3.0, 0.0}}});
+        game.CompleteTick(500ms);
+        game.CompleteTick(1000ms);
+        const std::vector snapshot{CaptureSession(game.session)};
+        SaveSnapshotFile(snapshot_path, snapshot);
+
+        game.Apply(journal::LootPickedUp{"map1"s, game.NextTick(), Dog::Id{1}, LostObject::Id{7}});
+        game.Apply(journal::DogJoined{"map1"s, game.NextTick(), Dog::Id{2}, "Rex"s, {1.0, 1.0}, 2});
+        game.Apply(journal::DogMoved{"map1"s, game.NextTick(), Dog::Id{2}, Direction::NORTH, {0.0, -1.0}});
+        game.CompleteTick(250ms);
+        game.Apply(journal::DogRetired{"map1"s, game.NextTick(), Dog::Id{1}});
+        game.CompleteTick(250ms);
+        // Действия незавершённого тика не сохранены
+        game.journal.Append(journal::DogRetired{"map1"s, game.NextTick(), Dog::Id{2}});
+
+        WHEN("the server restarts") {
+            auto sessions = LoadSnapshotFile(snapshot_path);
+            std::vector<GameSession> restored;
+            for (const auto& session : sessions) {
+                restored.push_back(RestoreSession(session));
+            }
+            ReplayJournal(ReadJournal(journal_path), restored, MoveDogs);
+
+            THEN("the state of the last committed tick is recovered") {
+                REQUIRE(restored.size() == 1);
+                CHECK(CaptureSession(restored.front()) == CaptureSession(game.session));
+            }
+        }
+
+        WHEN("the journal does not continue the snapshot") {
+            std::vector<GameSession> restored{RestoreSession(snapshot.front())};
+            const std::vector<JournalRecord> records{
+                journal::TickCompleted{"map1"s, game.session.GetTick() + 5, 10ms}};
+
+            THEN("replay fails") {
+                CHECK_THROWS_AS(ReplayJournal(records, restored), std::runtime_error);
+            }
+        }
+    }
+}
@@ -0,0 +1,72 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/player_pool.h"
+
+using namespace model;
+
+namespace {
+
+Player MakePlayer(uint32_t id) {
+    Player player;
+    player.id = Player::Id{id};
+    return player;
+}
+
+}  // namespace
+
+SCENARIO("Player pool") {
+    GIVEN("a pool with more players than fit in one chunk") {
+        PlayerPool pool;
+        std::vector<PlayerHandle> handles;
+        std::vector<const Player*> addresses;
+        for (uint32_t i = 0; i < PlayerPool::CHUNK_SIZE * 2 + 1; ++i) {
+            handles.push_back(pool.Add(MakePlayer(i)));
+            addresses.push_back(pool.Get(handles.back()));
+        }
+
+        THEN("players keep their addresses while the pool grows") {
+            CHECK(pool.GetSize() == handles.size());
+            for (size_t i = 0; i < handles.size(); ++i) {
+                REQUIRE(pool.Get(handles[i]) == addresses[i]);
+                CHECK(pool.Get(handles[i])->id == Player::Id{static_cast<uint32_t>(i)});
+            }
+        }
+
+        WHEN("a player is removed") {
+            REQUIRE(pool.Remove(handles[1]));
+
+            THEN("its handle becomes stale") {
+                CHECK_FALSE(pool.IsValid(handles[1]));
+                CHECK(pool.Get(handles[1]) == nullptr);
+                CHECK_FALSE(pool.Remove(handles[1]));
+                CHECK(pool.GetSize() == handles.size() - 1);
+            }
+
+            THEN("other players stay in place") {
+                CHECK(pool.Get(handles[0]) == addresses[0]);
+                CHECK(pool.Get(handles[2]) == addresses[2]);
+            }
+
+            AND_WHEN("another player is added") {
+                const PlayerHandle added = pool.Add(MakePlayer(1000));
+
+                THEN("the freed slot is reused with a new generation") {
+                    CHECK(added.index == handles[1].index);
+                    CHECK(added.generation != handles[1].generation);
+                    CHECK(pool.Get(handles[1]) == nullptr);
+                    CHECK(pool.Get(added)->id == Player::Id{1000u});
+                }
+            }
+        }
+
+        WHEN("players from the pool are indexed by token") {
+            PlayerTokens tokens;
+            const Token token = tokens.AddPlayer(*pool.Get(handles.back()));
+            pool.Add(MakePlayer(1001));
+
+            THEN("the token still resolves to the same player") {
+                CHECK(tokens.FindPlayer(token) == addresses.back());
+            }
+        }
+    }
+}
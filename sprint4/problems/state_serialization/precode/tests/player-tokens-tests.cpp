@@ -0,0 +1,69 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/player_tokens.h"
+
+using namespace model;
+using namespace std::literals;
+
+SCENARIO("Token hex conversion") {
+    GIVEN("a token") {
+        const Token token{0x0123456789abcdefull, 0xfedcba9876543210ull};
+
+        THEN("it is converted to 32 hex digits and back") {
+            CHECK(token.ToHex() == "0123456789abcdeffedcba9876543210"s);
+            CHECK(Token::FromHex(token.ToHex()) == token);
+            CHECK(Token::FromHex("0123456789ABCDEFFEDCBA9876543210"sv) == token);
+        }
+
+        THEN("malformed tokens are rejected") {
+            CHECK_FALSE(Token::FromHex(""sv));
+            CHECK_FALSE(Token::FromHex("0123456789abcdeffedcba987654321"sv));
+            CHECK_FALSE(Token::FromHex("0123456789abcdeffedcba98765432100"sv));
+            CHECK_FALSE(Token::FromHex("0123456789abcdeffedcba987654321g"sv));
+        }
+    }
+}
+
+SCENARIO("Player token index") {
+    GIVEN("an index with many players") {
+        PlayerTokens tokens;
+        std::vector<Player> players(1000);
+        std::vector<Token> issued;
+        for (uint32_t i = 0; i < players.size(); ++i) {
+            players[i].id = Player::Id{i};
+            issued.push_back(tokens.AddPlayer(players[i]));
+        }
+
+        THEN("every token resolves to its player") {
+            CHECK(tokens.GetPlayerCount() == players.size());
+            for (size_t i = 0; i < players.size(); ++i) {
+                CHECK(tokens.FindPlayer(issued[i]) == &players[i]);
+                CHECK(tokens.FindPlayer(issued[i].ToHex()) == &players[i]);
+            }
+        }
+
+        THEN("duplicate tokens are not accepted") {
+            CHECK_FALSE(tokens.Insert(issued.front(), players.back()));
+            CHECK(tokens.FindPlayer(issued.front()) == &players.front());
+        }
+
+        THEN("unknown tokens are not found") {
+            CHECK(tokens.FindPlayer(Token{}) == nullptr);
+            CHECK(tokens.FindPlayer("not a token"sv) == nullptr);
+        }
+
+        WHEN("half of the players are removed") {
+            for (size_t i = 0; i < players.size(); i += 2) {
+                REQUIRE(tokens.Remove(issued[i]));
+            }
+
+            THEN("only remaining players are found") {
+                CHECK(tokens.GetPlayerCount() == players.size() / 2);
+                for (size_t i = 0; i < players.size(); ++i) {
+                    CHECK(tokens.FindPlayer(issued[i]) == (i % 2 == 0 ? nullptr : &players[i]));
+                }
+                CHECK_FALSE(tokens.Remove(issued.front()));
+            }
+        }
+    }
+}
@@ -0,0 +1,62 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "../src/small_vector.h"
+
+using util::SmallVector;
+
+SCENARIO("Small vector") {
+    GIVEN("a small vector with inline capacity 2") {
+        SmallVector<int, 2> values;
+
+        WHEN("it holds no more than inline capacity") {
+            values.push_back(1);
+            values.push_back(2);
+
+            THEN("elements are stored inline") {
+                CHECK_FALSE(values.is_spilled());
+                CHECK(values.size() == 2);
+                CHECK(values[0] == 1);
+                CHECK(values[1] == 2);
+            }
+        }
+
+        WHEN("more elements are added") {
+            for (int i = 0; i < 5; ++i) {
+                values.push_back(i);
+            }
+
+            THEN("elements spill to the heap in order") {
+                CHECK(values.is_spilled());
+                CHECK(std::vector<int>(values.begin(), values.end()) == std::vector{0, 1, 2, 3, 4});
+            }
+
+            AND_WHEN("it is cleared") {
+                values.clear();
+
+                THEN("it is empty") {
+                    CHECK(values.empty());
+                    CHECK(values.begin() == values.end());
+                }
+            }
+        }
+
+        WHEN("large capacity is reserved") {
+            values.reserve(10);
+
+            THEN("storage is allocated on the heap at once") {
+                CHECK(values.is_spilled());
+                CHECK(values.empty());
+            }
+        }
+
+        THEN("vectors with equal elements are equal regardless of storage") {
+            SmallVector<int, 2> spilled;
+            spilled.reserve(5);
+            values.push_back(7);
+            spilled.push_back(7);
+            CHECK(values == spilled);
+            spilled.push_back(8);
+            CHECK_FALSE(values == spilled);
+        }
+    }
+}